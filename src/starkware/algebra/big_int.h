@@ -1,10 +1,12 @@
 #ifndef STARKWARE_ALGEBRA_BIG_INT_H_
 #define STARKWARE_ALGEBRA_BIG_INT_H_
 
+#include <array>
 #include <cstddef>
 #include <iostream>
 #include <limits>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -23,6 +25,11 @@ template <size_t N>
 class BigInt {
  public:
   static constexpr size_t kDigits = N * std::numeric_limits<uint64_t>::digits;
+  // The number of characters written by ToHex(): "0x" followed by 16 hex digits per limb.
+  static constexpr size_t kHexSize = 2 + N * 2 * sizeof(uint64_t);
+  // The maximal number of characters written by ToDecimal(): the number of decimal digits of
+  // 2^kDigits - 1, which is floor(kDigits * log10(2)) + 1.
+  static constexpr size_t kMaxDecimalSize = kDigits * 30103 / 100000 + 1;
 
   BigInt() = default;
 
@@ -36,6 +43,30 @@ class BigInt {
 
   static BigInt RandomBigInt(Prng* prng);
 
+  /*
+    Parses a hexadecimal string, with or without a "0x" prefix. Both lower and upper case digits
+    are accepted. Throws if the string has no digits, has a character that is not a hex digit, or
+    if its value does not fit in N limbs. Does not allocate memory.
+  */
+  static BigInt FromHex(std::string_view hex);
+
+  /*
+    Same as FromHex(), for a decimal string (without a prefix).
+  */
+  static BigInt FromDecimal(std::string_view decimal);
+
+  /*
+    Reads a number from bytes, which holds its N limbs in little-endian order (the least
+    significant byte first). bytes must have exactly N * 8 bytes, and need not be aligned.
+  */
+  static BigInt FromLittleEndian(gsl::span<const gsl::byte> bytes);
+
+  /*
+    Writes the number to out in the format of FromLittleEndian(). out must have exactly N * 8
+    bytes.
+  */
+  void ToLittleEndian(gsl::span<gsl::byte> out) const;
+
   /*
     Returns pair of the form (result, overflow_occurred).
   */
@@ -58,9 +89,18 @@ class BigInt {
   /*
     Computes the inverse of *this in the field GF(prime).
     If prime is not a prime number, the behavior is undefined.
+    The inverse is computed as (*this)^(prime - 2), so the sequence of multiplications depends only
+    on prime, and not on *this. Use it for secret values.
   */
   BigInt InvModPrime(const BigInt& prime) const;
 
+  /*
+    Same as InvModPrime(), using the binary extended Euclidean algorithm, which is much faster.
+    prime must be odd. The algorithm branches on the bits of *this, so its running time depends on
+    *this: use it only for public values (e.g., the s of a signature, or inputs to verification).
+  */
+  BigInt InvModPrimeVariableTime(const BigInt& prime) const;
+
   /*
     Return pair of the form (result, underflow_occurred).
   */
@@ -80,7 +120,20 @@ class BigInt {
   std::pair<BigInt, BigInt> Div(const BigInt& divisor) const;
 
   /*
-    Returns the representation of the number as a string of the form "0x...".
+    Writes the representation of the number as a string of the form "0x...", with 16 lower case
+    hex digits per limb, to out, and returns the number of characters written (kHexSize). out must
+    have room for kHexSize characters. No null terminator is written, and no memory is allocated.
+  */
+  size_t ToHex(gsl::span<char> out) const;
+
+  /*
+    Same as ToHex(), for the decimal representation of the number, without leading zeros. out must
+    have room for kMaxDecimalSize characters.
+  */
+  size_t ToDecimal(gsl::span<char> out) const;
+
+  /*
+    Returns the representation of the number as a string of the form "0x..." (see ToHex()).
   */
   std::string ToString() const;
 
@@ -119,6 +172,11 @@ class BigInt {
   constexpr size_t NumLeadingZeros() const;
 
  private:
+  /*
+    Shifts value one bit to the right, and sets its most significant bit to top_bit.
+  */
+  static constexpr void ShiftRightByOne(BigInt* value, bool top_bit);
+
   std::array<uint64_t, N> value_;
 };
 
@@ -1,13 +1,59 @@
-#include <iomanip>
-#include <ios>
+#include <algorithm>
+#include <cstring>
 #include <limits>
-#include <sstream>
 #include <tuple>
 
 #include "starkware/utils/math.h"
+#include "starkware/utils/portable_endian.h"
 
 namespace starkware {
 
+namespace bigint {
+namespace details {
+
+constexpr uint8_t kInvalidHexDigit = 0xff;
+
+constexpr std::array<uint8_t, 256> MakeHexDigitValues() {
+  std::array<uint8_t, 256> values{};
+  for (size_t c = 0; c < values.size(); ++c) {
+    values[c] = kInvalidHexDigit;
+  }
+  for (uint8_t d = 0; d < 10; ++d) {
+    values['0' + d] = d;
+  }
+  for (uint8_t d = 0; d < 6; ++d) {
+    values['a' + d] = 10 + d;
+    values['A' + d] = 10 + d;
+  }
+  return values;
+}
+
+constexpr std::array<char, 512> MakeHexBytes() {
+  constexpr std::array<char, 16> kHexDigits = {'0', '1', '2', '3', '4', '5', '6', '7',
+                                               '8', '9', 'a', 'b', 'c', 'd', 'e', 'f'};
+  std::array<char, 512> bytes{};
+  for (size_t b = 0; b < 256; ++b) {
+    bytes[2 * b] = kHexDigits[b >> 4];
+    bytes[2 * b + 1] = kHexDigits[b & 0xf];
+  }
+  return bytes;
+}
+
+// kHexDigitValues[c] is the value of the hex digit c, or kInvalidHexDigit if c is not a hex digit.
+inline constexpr std::array<uint8_t, 256> kHexDigitValues = MakeHexDigitValues();
+
+// kHexBytes[2 * b] and kHexBytes[2 * b + 1] are the two hex digits of the byte b, so that the hex
+// digits are written a byte at a time.
+inline constexpr std::array<char, 512> kHexBytes = MakeHexBytes();
+
+// Decimal strings are converted in chunks of kDecimalChunkDigits digits, which are the largest
+// chunks that fit in a uint64_t.
+constexpr size_t kDecimalChunkDigits = 19;
+constexpr uint64_t kDecimalChunkBase = 10000000000000000000ULL;
+
+}  // namespace details
+}  // namespace bigint
+
 template <size_t N>
 BigInt<N> BigInt<N>::RandomBigInt(Prng* prng) {
   std::array<uint64_t, N> value{};
@@ -87,6 +133,64 @@ BigInt<N> BigInt<N>::InvModPrime(const BigInt& prime) const {
       [&prime](const BigInt& multiplier, BigInt* dst) { *dst = MulMod(*dst, multiplier, prime); });
 }
 
+template <size_t N>
+BigInt<N> BigInt<N>::InvModPrimeVariableTime(const BigInt& prime) const {
+  ASSERT(*this != BigInt::Zero(), "Inverse of 0 is not defined.");
+  ASSERT((prime[0] & 1) != 0, "InvModPrimeVariableTime() requires an odd prime.");
+  // The binary extended Euclidean algorithm. Throughout the loop, x1 * (*this) == u and
+  // x2 * (*this) == v modulo prime.
+  BigInt u = Div(prime).second;
+  if (u == BigInt::Zero()) {
+    return u;
+  }
+  BigInt v = prime;
+  BigInt x1 = BigInt::One();
+  BigInt x2 = BigInt::Zero();
+
+  // Divides u by 2, and x by 2 modulo prime.
+  const auto halve = [&prime](BigInt* u, BigInt* x) {
+    ShiftRightByOne(u, false);
+    if (((*x)[0] & 1) == 0) {
+      ShiftRightByOne(x, false);
+    } else {
+      const auto [sum, carry] = Add(*x, prime);
+      *x = sum;
+      ShiftRightByOne(x, carry);
+    }
+  };
+  // Sets x to x - y modulo prime, where both are smaller than prime.
+  const auto sub_mod = [&prime](BigInt* x, const BigInt& y) {
+    const auto [diff, borrow] = Sub(*x, y);
+    *x = borrow ? diff + prime : diff;
+  };
+
+  while (u != BigInt::One() && v != BigInt::One()) {
+    while ((u[0] & 1) == 0) {
+      halve(&u, &x1);
+    }
+    while ((v[0] & 1) == 0) {
+      halve(&v, &x2);
+    }
+    if (u >= v) {
+      u = u - v;
+      sub_mod(&x1, x2);
+    } else {
+      v = v - u;
+      sub_mod(&x2, x1);
+    }
+  }
+  return u == BigInt::One() ? x1 : x2;
+}
+
+template <size_t N>
+constexpr void BigInt<N>::ShiftRightByOne(BigInt* value, bool top_bit) {
+  constexpr size_t kLimbBits = std::numeric_limits<uint64_t>::digits;
+  for (size_t i = 0; i + 1 < N; ++i) {
+    (*value)[i] = ((*value)[i] >> 1) | ((*value)[i + 1] << (kLimbBits - 1));
+  }
+  (*value)[N - 1] = ((*value)[N - 1] >> 1) | (static_cast<uint64_t>(top_bit) << (kLimbBits - 1));
+}
+
 template <size_t N>
 constexpr std::pair<BigInt<N>, bool> BigInt<N>::Sub(const BigInt& a, const BigInt& b) {
   bool carry{};
@@ -108,39 +212,174 @@ constexpr bool BigInt<N>::operator<(const BigInt& b) const {
 
 template <size_t N>
 std::pair<BigInt<N>, BigInt<N>> BigInt<N>::Div(const BigInt& divisor) const {
-  // This is a simple long-division implementation. It is not very efficient and can be improved
-  // if this function becomes a bottleneck.
+  // A binary long division: the divisor is aligned with the most significant bit of *this, and then
+  // shifted right one bit at a time.
   ASSERT(divisor != BigInt::Zero(), "Divisor must not be zero.");
 
-  bool carry{};
   BigInt res{};
-  BigInt shifted_divisor{}, tmp{};
   BigInt a = *this;
+  if (a < divisor) {
+    return {res, a};
+  }
 
-  while (a >= divisor) {
-    tmp = divisor;
-    int shift = -1;
-    do {
-      shifted_divisor = tmp;
-      shift++;
-      std::tie(tmp, carry) = Add(shifted_divisor, shifted_divisor);
-    } while (!carry && tmp <= a);
-
-    a = Sub(a, shifted_divisor).first;
-    res[shift / 64] |= Pow2(shift % 64);
+  const size_t shift = divisor.NumLeadingZeros() - a.NumLeadingZeros();
+  BigInt shifted_divisor = divisor;
+  for (size_t i = 0; i < shift; ++i) {
+    shifted_divisor = shifted_divisor + shifted_divisor;
+  }
+  for (size_t i = shift + 1; i-- > 0;) {
+    if (a >= shifted_divisor) {
+      a = Sub(a, shifted_divisor).first;
+      res[i / 64] |= Pow2(i % 64);
+    }
+    ShiftRightByOne(&shifted_divisor, false);
   }
 
   return {res, a};
 }
 
 template <size_t N>
-std::string BigInt<N>::ToString() const {
-  std::ostringstream res;
-  res << "0x";
-  for (int i = N - 1; i >= 0; --i) {
-    res << std::setfill('0') << std::setw(16) << std::hex << (*this)[i];
+BigInt<N> BigInt<N>::FromHex(std::string_view hex) {
+  using bigint::details::kHexDigitValues;
+  using bigint::details::kInvalidHexDigit;
+  constexpr size_t kNibblesPerLimb = 2 * sizeof(uint64_t);
+
+  if (hex.size() >= 2 && hex[0] == '0' && (hex[1] == 'x' || hex[1] == 'X')) {
+    hex.remove_prefix(2);
   }
-  return res.str();
+  ASSERT(!hex.empty(), "Hex string has no digits.");
+  const size_t first_nonzero = std::min(hex.find_first_not_of('0'), hex.size() - 1);
+  hex.remove_prefix(first_nonzero);
+  ASSERT(hex.size() <= N * kNibblesPerLimb, "Hex string is out of range.");
+
+  BigInt res = Zero();
+  for (size_t i = 0; i < hex.size(); ++i) {
+    const uint8_t nibble = kHexDigitValues[static_cast<uint8_t>(hex[hex.size() - 1 - i])];
+    ASSERT(nibble != kInvalidHexDigit, "Invalid hex digit.");
+    res.value_[i / kNibblesPerLimb] |= uint64_t{nibble} << (4 * (i % kNibblesPerLimb));
+  }
+  return res;
+}
+
+template <size_t N>
+BigInt<N> BigInt<N>::FromDecimal(std::string_view decimal) {
+  using bigint::details::kDecimalChunkDigits;
+  ASSERT(!decimal.empty(), "Decimal string has no digits.");
+
+  BigInt res = Zero();
+  // The first chunk is the shorter one, so that all the others are full.
+  size_t chunk_digits = (decimal.size() - 1) % kDecimalChunkDigits + 1;
+  for (size_t pos = 0; pos < decimal.size(); pos += chunk_digits) {
+    if (pos != 0) {
+      chunk_digits = kDecimalChunkDigits;
+    }
+    uint64_t chunk = 0;
+    uint64_t chunk_base = 1;
+    for (const char c : decimal.substr(pos, chunk_digits)) {
+      ASSERT('0' <= c && c <= '9', "Invalid decimal digit.");
+      chunk = chunk * 10 + static_cast<uint64_t>(c - '0');
+      chunk_base *= 10;
+    }
+    // res = res * chunk_base + chunk.
+    uint64_t carry = chunk;
+    for (uint64_t& limb : res.value_) {
+      const __uint128_t value = Umul128(limb, chunk_base) + carry;
+      limb = static_cast<uint64_t>(value);
+      carry = static_cast<uint64_t>(value >> 64);
+    }
+    ASSERT(carry == 0, "Decimal string is out of range.");
+  }
+  return res;
+}
+
+template <size_t N>
+BigInt<N> BigInt<N>::FromLittleEndian(gsl::span<const gsl::byte> bytes) {
+  ASSERT(bytes.size() == N * sizeof(uint64_t), "Span size mismatches BigInt size.");
+  BigInt res;
+  memcpy(res.value_.data(), bytes.data(), bytes.size());
+  for (uint64_t& limb : res.value_) {
+    limb = le64toh(limb);
+  }
+  return res;
+}
+
+template <size_t N>
+void BigInt<N>::ToLittleEndian(gsl::span<gsl::byte> out) const {
+  ASSERT(out.size() == N * sizeof(uint64_t), "Span size mismatches BigInt size.");
+  for (size_t i = 0; i < N; ++i) {
+    const uint64_t limb = htole64(value_[i]);
+    memcpy(out.data() + i * sizeof(uint64_t), &limb, sizeof(uint64_t));
+  }
+}
+
+template <size_t N>
+size_t BigInt<N>::ToHex(gsl::span<char> out) const {
+  using bigint::details::kHexBytes;
+  ASSERT(out.size() >= kHexSize, "Output span is too small.");
+  out[0] = '0';
+  out[1] = 'x';
+  char* digits = out.data() + 2;
+  for (size_t i = 0; i < N; ++i) {
+    const uint64_t limb = value_[N - 1 - i];
+    for (size_t j = 0; j < sizeof(uint64_t); ++j) {
+      const size_t byte = (limb >> (8 * (sizeof(uint64_t) - 1 - j))) & 0xff;
+      digits[0] = kHexBytes[2 * byte];
+      digits[1] = kHexBytes[2 * byte + 1];
+      digits += 2;
+    }
+  }
+  return kHexSize;
+}
+
+template <size_t N>
+size_t BigInt<N>::ToDecimal(gsl::span<char> out) const {
+  using bigint::details::kDecimalChunkBase;
+  using bigint::details::kDecimalChunkDigits;
+
+  // Split the number to chunks of kDecimalChunkDigits digits, starting from the least significant
+  // one, by dividing it by kDecimalChunkBase.
+  std::array<uint64_t, kMaxDecimalSize / kDecimalChunkDigits + 1> chunks{};
+  size_t n_chunks = 0;
+  std::array<uint64_t, N> quotient = value_;
+  size_t n_limbs = N;
+  do {
+    uint64_t remainder = 0;
+    for (size_t i = n_limbs; i-- > 0;) {
+      const __uint128_t value = (static_cast<__uint128_t>(remainder) << 64) | quotient[i];
+      quotient[i] = static_cast<uint64_t>(value / kDecimalChunkBase);
+      remainder = static_cast<uint64_t>(value % kDecimalChunkBase);
+    }
+    chunks[n_chunks++] = remainder;
+    while (n_limbs > 0 && quotient[n_limbs - 1] == 0) {
+      --n_limbs;
+    }
+  } while (n_limbs > 0);
+
+  // The most significant chunk is written without leading zeros, and the others with them.
+  size_t top_chunk_digits = 1;
+  for (uint64_t chunk = chunks[n_chunks - 1]; chunk >= 10; chunk /= 10) {
+    ++top_chunk_digits;
+  }
+  const size_t size = top_chunk_digits + (n_chunks - 1) * kDecimalChunkDigits;
+  ASSERT(out.size() >= size, "Output span is too small.");
+
+  char* digit = out.data() + size;
+  for (size_t i = 0; i < n_chunks; ++i) {
+    uint64_t chunk = chunks[i];
+    const size_t chunk_digits = i + 1 < n_chunks ? kDecimalChunkDigits : top_chunk_digits;
+    for (size_t j = 0; j < chunk_digits; ++j) {
+      *--digit = static_cast<char>('0' + chunk % 10);
+      chunk /= 10;
+    }
+  }
+  return size;
+}
+
+template <size_t N>
+std::string BigInt<N>::ToString() const {
+  std::array<char, kHexSize> hex{};
+  ToHex(hex);
+  return std::string(hex.data(), hex.size());
 }
 
 template <size_t N>
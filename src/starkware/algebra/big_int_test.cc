@@ -1,6 +1,8 @@
 #include "starkware/algebra/big_int.h"
 
+#include <array>
 #include <limits>
+#include <string>
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
@@ -112,9 +114,32 @@ TEST(BigInt, InvMod) {
   EXPECT_EQ(BigInt<4>::MulMod(val, inv, prime), 0x1_Z);
 }
 
+TEST(BigInt, InvModRandom) {
+  Prng prng;
+  for (const BigInt<4>& prime :
+       {0xf04a65fa008b9e14bfe07094f9ff9bb7363ae6512e213a0a104adb17fb81b385_Z,
+        0x800000000000010ffffffffffffffffb781126dcae7b2321e66a241adc64d2f_Z,
+        BigInt<4>(7)}) {
+    for (size_t i = 0; i < 20; ++i) {
+      // Values are not necessarily smaller than prime.
+      auto val = BigInt<4>::RandomBigInt(&prng);
+      if (val.Div(prime).second == BigInt<4>::Zero()) {
+        val = val + BigInt<4>::One();
+      }
+      const auto inv = val.InvModPrime(prime);
+      EXPECT_LT(inv, prime);
+      EXPECT_EQ(BigInt<4>::MulMod(val, inv, prime), 0x1_Z);
+      EXPECT_EQ(val.InvModPrimeVariableTime(prime), inv);
+    }
+  }
+  EXPECT_EQ(BigInt<4>::One().InvModPrime(BigInt<4>(7)), BigInt<4>::One());
+  EXPECT_EQ(BigInt<4>::One().InvModPrimeVariableTime(BigInt<4>(7)), BigInt<4>::One());
+}
+
 TEST(BigInt, InvMod_Zero) {
   const auto prime = 0xf04a65fa008b9e14bfe07094f9ff9bb7363ae6512e213a0a104adb17fb81b385_Z;
   EXPECT_ASSERT(BigInt<4>::Zero().InvModPrime(prime), HasSubstr("Inverse of 0"));
+  EXPECT_ASSERT(BigInt<4>::Zero().InvModPrimeVariableTime(prime), HasSubstr("Inverse of 0"));
 }
 
 TEST(BigInt, UserLiteral) {
@@ -174,5 +199,95 @@ TEST(BigInt, UserLiteral2) {
             zero);  // Works due to implicit cast of BigInt<2> to BigInt<1>.
 }
 
+TEST(BigInt, ToString) {
+  EXPECT_EQ(
+      (0x800000000000011000000000000000000000000000000000000000000000001_Z).ToString(),
+      "0x0800000000000011000000000000000000000000000000000000000000000001");
+  EXPECT_EQ(BigInt<1>::Zero().ToString(), "0x0000000000000000");
+}
+
+TEST(BigInt, FromHex) {
+  const auto expected = 0x3c1e9550e66958296d11b60f8e8e7a7ad990d07fa65d5f7652c4a6c87d4e3cc_Z;
+  EXPECT_EQ(
+      BigInt<4>::FromHex("0x3c1e9550e66958296d11b60f8e8e7a7ad990d07fa65d5f7652c4a6c87d4e3cc"),
+      expected);
+  EXPECT_EQ(
+      BigInt<4>::FromHex("03C1E9550E66958296D11B60F8E8E7A7AD990D07FA65D5F7652C4A6C87D4E3CC"),
+      expected);
+  EXPECT_EQ(BigInt<4>::FromHex("0x0"), BigInt<4>::Zero());
+  EXPECT_EQ(BigInt<2>::FromHex("0x00000000000000000000000000000000000000001"), BigInt<2>::One());
+
+  EXPECT_ASSERT(BigInt<4>::FromHex("0x"), HasSubstr("no digits"));
+  EXPECT_ASSERT(BigInt<4>::FromHex("0x12g4"), HasSubstr("Invalid hex digit"));
+  EXPECT_ASSERT(BigInt<1>::FromHex("0x10000000000000000"), HasSubstr("out of range"));
+}
+
+TEST(BigInt, FromDecimal) {
+  EXPECT_EQ(
+      BigInt<4>::FromDecimal(
+          "3618502788666131213697322783095070105623107215331596699973092056135872020481"),
+      0x800000000000011000000000000000000000000000000000000000000000001_Z);
+  EXPECT_EQ(BigInt<1>::FromDecimal("18446744073709551615"), BigInt<1>(~uint64_t(0)));
+  EXPECT_EQ(BigInt<2>::FromDecimal("00000000000000000000000000000042"), BigInt<2>(42));
+
+  EXPECT_ASSERT(BigInt<1>::FromDecimal(""), HasSubstr("no digits"));
+  EXPECT_ASSERT(BigInt<1>::FromDecimal("0x12"), HasSubstr("Invalid decimal digit"));
+  EXPECT_ASSERT(BigInt<1>::FromDecimal("18446744073709551616"), HasSubstr("out of range"));
+}
+
+TEST(BigInt, ToDecimal) {
+  std::array<char, BigInt<4>::kMaxDecimalSize> out{};
+  const auto to_decimal = [&out](const BigInt<4>& value) {
+    return std::string(out.data(), value.ToDecimal(out));
+  };
+  EXPECT_EQ(to_decimal(BigInt<4>::Zero()), "0");
+  EXPECT_EQ(to_decimal(BigInt<4>(10000000000000000000ULL)), "10000000000000000000");
+  EXPECT_EQ(
+      to_decimal(-BigInt<4>::One()),
+      "115792089237316195423570985008687907853269984665640564039457584007913129639935");
+  EXPECT_EQ(to_decimal(-BigInt<4>::One()).size(), BigInt<4>::kMaxDecimalSize);
+
+  std::array<char, 2> small_out{};
+  EXPECT_ASSERT(BigInt<4>(100).ToDecimal(small_out), HasSubstr("too small"));
+}
+
+TEST(BigInt, HexAndDecimalRandom) {
+  Prng prng;
+  std::array<char, BigInt<4>::kMaxDecimalSize> out{};
+  for (size_t i = 0; i < 100; ++i) {
+    // Random values of random bit lengths.
+    BigInt<4> value = BigInt<4>::RandomBigInt(&prng);
+    for (uint64_t shift = prng.RandomUint64(0, 255); shift > 0; --shift) {
+      value = value.Div(BigInt<4>(2)).first;
+    }
+    EXPECT_EQ(BigInt<4>::FromHex(std::string_view(out.data(), value.ToHex(out))), value);
+    EXPECT_EQ(BigInt<4>::FromDecimal(std::string_view(out.data(), value.ToDecimal(out))), value);
+  }
+}
+
+TEST(BigInt, LittleEndian) {
+  const auto value = 0x0807060504030201100f0e0d0c0b0a09_Z;
+  const std::array<uint8_t, 16> expected = {9, 10, 11, 12, 13, 14, 15, 16, 1, 2, 3, 4, 5, 6, 7, 8};
+  std::array<gsl::byte, 16> bytes{};
+  value.ToLittleEndian(bytes);
+  for (size_t i = 0; i < bytes.size(); ++i) {
+    EXPECT_EQ(static_cast<uint8_t>(bytes[i]), expected[i]);
+  }
+  EXPECT_EQ(BigInt<2>::FromLittleEndian(bytes), value);
+
+  EXPECT_ASSERT(BigInt<2>::FromLittleEndian(gsl::make_span(bytes).first(15)), HasSubstr("size"));
+  EXPECT_ASSERT(BigInt<1>(1).ToLittleEndian(bytes), HasSubstr("size"));
+}
+
+TEST(BigInt, LittleEndianRandom) {
+  Prng prng;
+  std::array<gsl::byte, 32> bytes{};
+  for (size_t i = 0; i < 100; ++i) {
+    const auto value = BigInt<4>::RandomBigInt(&prng);
+    value.ToLittleEndian(bytes);
+    EXPECT_EQ(BigInt<4>::FromLittleEndian(bytes), value);
+  }
+}
+
 }  // namespace
 }  // namespace starkware
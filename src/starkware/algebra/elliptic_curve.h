@@ -60,16 +60,43 @@ class EcPoint {
   EcPoint<FieldElementT> MultiplyByScalar(
       const BigInt<N>& scalar, const FieldElementT& alpha) const;
 
-  FieldElementT x;
-  FieldElementT y;
+  /*
+    Returns the x coordinate of scalar * P, where P is a point whose x coordinate is x, on the curve
+    "y^2 = x^3 + alpha * x + beta". Returns std::nullopt if scalar * P is the curve's zero element.
+    x must not be zero.
+
+    Uses the x-only Montgomery ladder of Brier and Joye in projective coordinates: every bit of
+    the scalar costs one doubling and one differential addition, with the same sequence of field
+    operations regardless of its value (the points are swapped arithmetically), and a single field
+    inversion is needed at the end. Multiplications by alpha are skipped when alpha is 1.
+  */
+  template <size_t N>
+  static std::optional<FieldElementT> MultiplyXOnly(
+      const FieldElementT& x, const BigInt<N>& scalar, const FieldElementT& alpha,
+      const FieldElementT& beta);
 
- private:
   /*
     Returns the sum of this point with a point in the form of std::optional, where std::nullopt
     represents the curve's zero element.
   */
   std::optional<EcPoint<FieldElementT>> AddOptionalPoint(
       const std::optional<EcPoint<FieldElementT>>& point, const FieldElementT& alpha) const;
+
+  /*
+    Returns sum(scalars[i] * points[i]), or std::nullopt if the sum is the curve's zero element.
+
+    Uses Straus' method with 4-bit windows: the doublings are shared by all the points, so besides a
+    table of 14 additions per point, the cost is a single chain of doublings plus about one addition
+    per 4 bits of each scalar. For a large number of points, this is several times faster than
+    calling MultiplyByScalar() on each of them.
+  */
+  template <size_t N>
+  static std::optional<EcPoint> MultiScalarMultiply(
+      gsl::span<const EcPoint> points, gsl::span<const BigInt<N>> scalars,
+      const FieldElementT& alpha);
+
+  FieldElementT x;
+  FieldElementT y;
 };
 
 }  // namespace starkware
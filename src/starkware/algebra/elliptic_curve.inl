@@ -1,3 +1,5 @@
+#include <limits>
+
 #include "starkware/utils/error_handling.h"
 
 namespace starkware {
@@ -110,6 +112,120 @@ EcPoint<FieldElementT> EcPoint<FieldElementT>::MultiplyByScalar(
   return *res;
 }
 
+template <typename FieldElementT>
+template <size_t N>
+std::optional<FieldElementT> EcPoint<FieldElementT>::MultiplyXOnly(
+    const FieldElementT& x, const BigInt<N>& scalar, const FieldElementT& alpha,
+    const FieldElementT& beta) {
+  ASSERT(x != FieldElementT::Zero(), "x must not be zero.");
+  constexpr size_t kLimbBits = std::numeric_limits<uint64_t>::digits;
+  const bool alpha_is_one = alpha == FieldElementT::One();
+  const auto times_alpha = [&alpha, alpha_is_one](const FieldElementT& value) {
+    return alpha_is_one ? value : alpha * value;
+  };
+  const FieldElementT two_beta = beta + beta;
+  const FieldElementT four_beta = two_beta + two_beta;
+  const FieldElementT eight_beta = four_beta + four_beta;
+  // Swaps a and b if condition is 1, without branching on condition.
+  const auto conditional_swap = [](FieldElementT* a, FieldElementT* b, uint64_t condition) {
+    const FieldElementT diff = FieldElementT::FromUint(condition) * (*a - *b);
+    *a = *a - diff;
+    *b = *b + diff;
+  };
+
+  // (x0 : z0) and (x1 : z1) are the projective x coordinates of m * P and (m + 1) * P, where m is
+  // the prefix of the scalar that was processed. The zero element is (1 : 0), so leading zero bits
+  // need no special treatment.
+  FieldElementT x0 = FieldElementT::One();
+  FieldElementT z0 = FieldElementT::Zero();
+  FieldElementT x1 = x;
+  FieldElementT z1 = FieldElementT::One();
+  uint64_t swapped = 0;
+  for (size_t i = BigInt<N>::kDigits; i-- > 0;) {
+    const uint64_t bit = (scalar[gsl::narrow_cast<int>(i / kLimbBits)] >> (i % kLimbBits)) & 1;
+    // If the bit is set, the points are swapped, so that (2m + 2) * P and (2m + 1) * P are
+    // computed, and swapped back in the next iteration.
+    conditional_swap(&x0, &x1, bit ^ swapped);
+    conditional_swap(&z0, &z1, bit ^ swapped);
+    swapped = bit;
+
+    // The sum of the points, whose difference is P.
+    const FieldElementT x0_z1 = x0 * z1;
+    const FieldElementT x1_z0 = x1 * z0;
+    const FieldElementT z0_z1 = z0 * z1;
+    const FieldElementT sum_x_base = x0 * x1 - times_alpha(z0_z1);
+    const FieldElementT sum_z_base = x0_z1 - x1_z0;
+    const FieldElementT sum_x = sum_x_base * sum_x_base - four_beta * z0_z1 * (x0_z1 + x1_z0);
+    const FieldElementT sum_z = x * sum_z_base * sum_z_base;
+
+    // The double of (x0 : z0).
+    const FieldElementT x0_x0 = x0 * x0;
+    const FieldElementT z0_z0 = z0 * z0;
+    const FieldElementT x0_z0 = x0 * z0;
+    const FieldElementT alpha_z0_z0 = times_alpha(z0_z0);
+    const FieldElementT double_x_base = x0_x0 - alpha_z0_z0;
+    const FieldElementT double_z_base = x0_z0 * (x0_x0 + alpha_z0_z0) + beta * z0_z0 * z0_z0;
+    x0 = double_x_base * double_x_base - eight_beta * x0_z0 * z0_z0;
+    z0 = (double_z_base + double_z_base) + (double_z_base + double_z_base);
+    x1 = sum_x;
+    z1 = sum_z;
+  }
+  conditional_swap(&x0, &x1, swapped);
+  conditional_swap(&z0, &z1, swapped);
+
+  if (z0 == FieldElementT::Zero()) {
+    return std::nullopt;
+  }
+  return x0 / z0;
+}
+
+template <typename FieldElementT>
+template <size_t N>
+auto EcPoint<FieldElementT>::MultiScalarMultiply(
+    gsl::span<const EcPoint> points, gsl::span<const BigInt<N>> scalars,
+    const FieldElementT& alpha) -> std::optional<EcPoint> {
+  ASSERT(points.size() == scalars.size(), "Number of points and scalars mismatch.");
+  constexpr size_t kWindowBits = 4;
+  constexpr size_t kTableSize = (1 << kWindowBits) - 1;
+  constexpr size_t kLimbBits = std::numeric_limits<uint64_t>::digits;
+  static_assert(kLimbBits % kWindowBits == 0, "A window must not cross a limb.");
+
+  const auto add = [&alpha](
+                       const std::optional<EcPoint>& a,
+                       const std::optional<EcPoint>& b) -> std::optional<EcPoint> {
+    return b.has_value() ? b->AddOptionalPoint(a, alpha) : a;
+  };
+
+  // table[i * kTableSize + d - 1] is d * points[i], for d in [1, 2^kWindowBits).
+  std::vector<std::optional<EcPoint>> table;
+  table.reserve(points.size() * kTableSize);
+  for (const EcPoint& point : points) {
+    std::optional<EcPoint> multiple = point;
+    for (size_t d = 1; d <= kTableSize; ++d) {
+      table.push_back(multiple);
+      multiple = add(multiple, point);
+    }
+  }
+
+  std::optional<EcPoint> res;
+  for (size_t window = BigInt<N>::kDigits / kWindowBits; window-- > 0;) {
+    for (size_t i = 0; i < kWindowBits && res.has_value(); ++i) {
+      // A point whose y is zero is a 2-torsion, so doubling it gives the zero element.
+      res = res->y == FieldElementT::Zero() ? std::nullopt
+                                            : std::optional<EcPoint>(res->Double(alpha));
+    }
+    const size_t bit = window * kWindowBits;
+    const int limb = gsl::narrow_cast<int>(bit / kLimbBits);
+    for (size_t i = 0; i < points.size(); ++i) {
+      const size_t digit = (scalars[i][limb] >> (bit % kLimbBits)) & kTableSize;
+      if (digit != 0) {
+        res = add(res, table[i * kTableSize + digit - 1]);
+      }
+    }
+  }
+  return res;
+}
+
 template <typename FieldElementT>
 std::optional<EcPoint<FieldElementT>> EcPoint<FieldElementT>::AddOptionalPoint(
     const std::optional<EcPoint<FieldElementT>>& point, const FieldElementT& alpha) const {
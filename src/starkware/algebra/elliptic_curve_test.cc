@@ -1,6 +1,7 @@
 #include "starkware/algebra/elliptic_curve.h"
 
 #include <cstddef>
+#include <optional>
 #include <utility>
 #include <vector>
 
@@ -106,6 +107,71 @@ TEST(EllipticCurve, RandomPointOnCurve) {
   EXPECT_TRUE(point.y == point2->y || point.y == -point2->y);
 }
 
+TEST(EllipticCurve, MultiScalarMultiply) {
+  using FractionFieldElementT = FractionFieldElement<PrimeFieldElement>;
+  using EcPointT = EcPoint<FractionFieldElementT>;
+  Prng prng;
+  const PrimeFieldElement alpha = PrimeFieldElement::RandomElement(&prng);
+  const PrimeFieldElement beta = PrimeFieldElement::RandomElement(&prng);
+  const FractionFieldElementT fraction_alpha(alpha);
+
+  std::vector<EcPointT> points;
+  std::vector<BigInt<4>> scalars;
+  std::optional<EcPoint<PrimeFieldElement>> expected;
+  for (size_t i = 0; i < 5; ++i) {
+    const auto point = EcPoint<PrimeFieldElement>::Random(alpha, beta, &prng);
+    const auto scalar = BigInt<4>::RandomBigInt(&prng);
+    points.push_back(point.ConvertTo<FractionFieldElementT>());
+    scalars.push_back(scalar);
+    const auto product = point.MultiplyByScalar(scalar, alpha);
+    expected = expected.has_value() ? *expected + product : product;
+  }
+  const auto res = EcPointT::MultiScalarMultiply<4>(points, scalars, fraction_alpha);
+  ASSERT_TRUE(res.has_value());
+  EXPECT_EQ(res->x.ToBaseFieldElement(), expected->x);
+  EXPECT_EQ(res->y.ToBaseFieldElement(), expected->y);
+
+  // P + (-P) is the zero element, and a small scalar gives the same result as MultiplyByScalar().
+  const std::vector<EcPointT> opposite_points = {points[0], -points[0], points[1]};
+  const std::vector<BigInt<4>> small_scalars = {BigInt<4>(17), BigInt<4>(17), BigInt<4>(0)};
+  EXPECT_FALSE(EcPointT::MultiScalarMultiply<4>(opposite_points, small_scalars, fraction_alpha)
+                   .has_value());
+  const std::vector<BigInt<4>> single_scalar = {BigInt<4>(0x1234)};
+  EXPECT_EQ(
+      EcPointT::MultiScalarMultiply<4>(gsl::make_span(points).first(1), single_scalar,
+                                       fraction_alpha),
+      points[0].MultiplyByScalar(BigInt<4>(0x1234), fraction_alpha));
+  EXPECT_FALSE(EcPointT::MultiScalarMultiply<4>({}, {}, fraction_alpha).has_value());
+  EXPECT_ASSERT(
+      EcPointT::MultiScalarMultiply<4>(points, single_scalar, fraction_alpha),
+      HasSubstr("mismatch"));
+}
+
+TEST(EllipticCurve, MultiplyXOnly) {
+  Prng prng;
+  using ValueType = PrimeFieldElement::ValueType;
+  for (const PrimeFieldElement& alpha :
+       {PrimeFieldElement::One(), PrimeFieldElement::RandomElement(&prng)}) {
+    const PrimeFieldElement beta = PrimeFieldElement::RandomElement(&prng);
+    const auto point = EcPoint<PrimeFieldElement>::Random(alpha, beta, &prng);
+    for (const ValueType& scalar :
+         {ValueType::One(), ValueType(2), ValueType(7), ValueType::RandomBigInt(&prng),
+          ValueType::RandomBigInt(&prng)}) {
+      const auto res = EcPoint<PrimeFieldElement>::MultiplyXOnly(point.x, scalar, alpha, beta);
+      ASSERT_TRUE(res.has_value());
+      EXPECT_EQ(*res, point.MultiplyByScalar(scalar, alpha).x);
+    }
+    EXPECT_FALSE(EcPoint<PrimeFieldElement>::MultiplyXOnly(
+                     point.x, ValueType::Zero(), alpha, beta)
+                     .has_value());
+  }
+  EXPECT_ASSERT(
+      EcPoint<PrimeFieldElement>::MultiplyXOnly(
+          PrimeFieldElement::Zero(), ValueType::One(), PrimeFieldElement::One(),
+          PrimeFieldElement::One()),
+      HasSubstr("x must not be zero"));
+}
+
 TEST(EllipticCurve, TestConvertTo) {
   Prng prng;
   const PrimeFieldElement first_element = PrimeFieldElement::RandomElement(&prng);
@@ -0,0 +1,43 @@
+#ifndef STARKWARE_ALGEBRA_FIELD_OPERATIONS_H_
+#define STARKWARE_ALGEBRA_FIELD_OPERATIONS_H_
+
+#include <cstddef>
+
+#include "third_party/gsl/gsl-lite.hpp"
+
+#include "starkware/utils/error_handling.h"
+
+namespace starkware {
+
+/*
+  Computes the inverses of all the elements of input and writes them to output, using a single
+  field inversion and 3*(n-1) multiplications (Montgomery's trick).
+  input and output must have the same size and must not overlap. All the elements of input must be
+  non-zero.
+*/
+template <typename FieldElementT>
+void BatchInverse(gsl::span<const FieldElementT> input, gsl::span<FieldElementT> output) {
+  ASSERT(input.size() == output.size(), "Input and output sizes mismatch.");
+  const size_t n = input.size();
+  if (n == 0) {
+    return;
+  }
+
+  // output[i] = input[0] * ... * input[i].
+  output[0] = input[0];
+  for (size_t i = 1; i < n; ++i) {
+    output[i] = output[i - 1] * input[i];
+  }
+
+  // Invariant: inv = (input[0] * ... * input[i])^(-1).
+  FieldElementT inv = output[n - 1].Inverse();
+  for (size_t i = n - 1; i > 0; --i) {
+    output[i] = output[i - 1] * inv;
+    inv = inv * input[i];
+  }
+  output[0] = inv;
+}
+
+}  // namespace starkware
+
+#endif  // STARKWARE_ALGEBRA_FIELD_OPERATIONS_H_
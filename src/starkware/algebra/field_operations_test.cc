@@ -0,0 +1,51 @@
+#include "starkware/algebra/field_operations.h"
+
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "starkware/algebra/prime_field_element.h"
+#include "starkware/utils/prng.h"
+#include "starkware/utils/test_utils.h"
+
+namespace starkware {
+namespace {
+
+using testing::HasSubstr;
+
+TEST(BatchInverse, Random) {
+  Prng prng;
+  for (size_t n : {1, 2, 17}) {
+    std::vector<PrimeFieldElement> input;
+    for (size_t i = 0; i < n; ++i) {
+      input.push_back(PrimeFieldElement::RandomElement(&prng));
+    }
+    std::vector<PrimeFieldElement> output(n, PrimeFieldElement::Zero());
+    BatchInverse<PrimeFieldElement>(input, output);
+    for (size_t i = 0; i < n; ++i) {
+      EXPECT_EQ(output[i], input[i].Inverse());
+    }
+  }
+}
+
+TEST(BatchInverse, Empty) {
+  std::vector<PrimeFieldElement> empty;
+  BatchInverse<PrimeFieldElement>(empty, empty);
+}
+
+TEST(BatchInverse, SizeMismatch) {
+  const std::vector<PrimeFieldElement> input(2, PrimeFieldElement::One());
+  std::vector<PrimeFieldElement> output(3, PrimeFieldElement::Zero());
+  EXPECT_ASSERT(BatchInverse<PrimeFieldElement>(input, output), HasSubstr("sizes mismatch"));
+}
+
+TEST(BatchInverse, Zero) {
+  const std::vector<PrimeFieldElement> input = {PrimeFieldElement::One(),
+                                                PrimeFieldElement::Zero()};
+  std::vector<PrimeFieldElement> output(2, PrimeFieldElement::Zero());
+  EXPECT_ASSERT(BatchInverse<PrimeFieldElement>(input, output), HasSubstr("Zero"));
+}
+
+}  // namespace
+}  // namespace starkware
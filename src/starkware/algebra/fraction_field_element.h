@@ -1,6 +1,8 @@
 #ifndef STARKWARE_ALGEBRA_FRACTION_FIELD_ELEMENT_H_
 #define STARKWARE_ALGEBRA_FRACTION_FIELD_ELEMENT_H_
 
+#include "third_party/gsl/gsl-lite.hpp"
+
 #include "starkware/utils/error_handling.h"
 #include "starkware/utils/prng.h"
 
@@ -61,6 +63,13 @@ class FractionFieldElement {
 
   FieldElementT ToBaseFieldElement() const { return this->numerator_ * denominator_.Inverse(); }
 
+  /*
+    Same as calling ToBaseFieldElement() on every element of input, but uses a single inversion of
+    the underlying field for the entire span (see BatchInverse()).
+  */
+  static void BatchToBaseFieldElement(
+      gsl::span<const FractionFieldElement> input, gsl::span<FieldElementT> output);
+
   explicit operator FieldElementT() const { return ToBaseFieldElement(); }
 
  private:
@@ -1,5 +1,8 @@
 #include "starkware/algebra/fraction_field_element.h"
 
+#include <vector>
+
+#include "starkware/algebra/field_operations.h"
 #include "starkware/utils/error_handling.h"
 
 namespace starkware {
@@ -39,4 +42,19 @@ FractionFieldElement<FieldElementT> FractionFieldElement<FieldElementT>::Inverse
   return FractionFieldElement(denominator_, numerator_);
 }
 
+template <typename FieldElementT>
+void FractionFieldElement<FieldElementT>::BatchToBaseFieldElement(
+    gsl::span<const FractionFieldElement<FieldElementT>> input, gsl::span<FieldElementT> output) {
+  ASSERT(input.size() == output.size(), "Input and output sizes mismatch.");
+  std::vector<FieldElementT> denominators;
+  denominators.reserve(input.size());
+  for (const auto& element : input) {
+    denominators.push_back(element.denominator_);
+  }
+  BatchInverse<FieldElementT>(denominators, output);
+  for (size_t i = 0; i < input.size(); ++i) {
+    output[i] = input[i].numerator_ * output[i];
+  }
+}
+
 }  // namespace starkware
@@ -117,5 +117,21 @@ TEST(FractionFieldElement, ToBaseFieldElement) {
       (FractionFieldElementT(a) / FractionFieldElementT(b)).ToBaseFieldElement(), a * b.Inverse());
 }
 
+TEST(FractionFieldElement, BatchToBaseFieldElement) {
+  Prng prng;
+  std::vector<FractionFieldElementT> input;
+  for (size_t i = 0; i < 10; ++i) {
+    input.push_back(
+        FractionFieldElementT(PrimeFieldElement::RandomElement(&prng)) /
+        FractionFieldElementT(PrimeFieldElement::RandomElement(&prng)));
+  }
+  input.push_back(FractionFieldElementT::Zero());
+  std::vector<PrimeFieldElement> output(input.size(), PrimeFieldElement::Zero());
+  FractionFieldElementT::BatchToBaseFieldElement(input, output);
+  for (size_t i = 0; i < input.size(); ++i) {
+    EXPECT_EQ(output[i], input[i].ToBaseFieldElement());
+  }
+}
+
 }  // namespace
 }  // namespace starkware
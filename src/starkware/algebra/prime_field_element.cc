@@ -2,6 +2,36 @@
 
 namespace starkware {
 
+namespace {
+
+using ValueType = PrimeFieldElement::ValueType;
+
+/*
+  Returns value modulo PrimeFieldElement::kModulus. The most significant limb of the modulus is at
+  least 2^59, so every value is smaller than 32 times the modulus, and is reduced with at most 31
+  subtractions, which is much cheaper than a division.
+*/
+ValueType Reduce(ValueType value) {
+  constexpr auto& kModulus = PrimeFieldElement::kModulus;
+  static_assert(
+      kModulus[ValueType::LimbCount() - 1] >= (uint64_t{1} << 59),
+      "The modulus is too small for Reduce().");
+  while (value >= kModulus) {
+    value = value - kModulus;
+  }
+  return value;
+}
+
+}  // namespace
+
+PrimeFieldElement PrimeFieldElement::FromHex(std::string_view hex) {
+  return FromBigInt(Reduce(ValueType::FromHex(hex)));
+}
+
+PrimeFieldElement PrimeFieldElement::FromDecimal(std::string_view decimal) {
+  return FromBigInt(Reduce(ValueType::FromDecimal(decimal)));
+}
+
 PrimeFieldElement PrimeFieldElement::RandomElement(Prng* prng) {
   constexpr size_t kMostSignificantLimb = ValueType::LimbCount() - 1;
   static_assert(
@@ -6,6 +6,7 @@
 #include <cstdint>
 #include <limits>
 #include <string>
+#include <string_view>
 #include <tuple>
 #include <utility>
 #include <vector>
@@ -49,6 +50,22 @@ class PrimeFieldElement {
         MontgomeryMul(val, kMontgomeryRSquared));
   }
 
+  /*
+    Returns the element whose Montgomery representation is val (see ToMontgomeryForm()), without any
+    conversion. val must be smaller than kModulus.
+  */
+  static PrimeFieldElement FromMontgomeryForm(const ValueType& val) {
+    ASSERT(val < kModulus, "Montgomery representation is out of range.");
+    return PrimeFieldElement(val);
+  }
+
+  /*
+    Parses a hexadecimal or a decimal string (see BigInt::FromHex() and BigInt::FromDecimal()).
+    Values that are not smaller than kModulus are reduced modulo kModulus.
+  */
+  static PrimeFieldElement FromHex(std::string_view hex);
+  static PrimeFieldElement FromDecimal(std::string_view decimal);
+
   static PrimeFieldElement RandomElement(Prng* prng);
 
   static constexpr PrimeFieldElement Zero() { return PrimeFieldElement(ValueType({})); }
@@ -110,6 +127,19 @@ class PrimeFieldElement {
   */
   ValueType ToStandardForm() const { return MontgomeryMul(value_, ValueType::One()); }
 
+  /*
+    Returns the Montgomery representation: the standard representation multiplied by kMontgomeryR,
+    modulo kModulus. Unlike ToStandardForm(), no computation is needed.
+  */
+  const ValueType& ToMontgomeryForm() const { return value_; }
+
+  /*
+    Writes the standard representation as a hexadecimal or a decimal string (see BigInt::ToHex()
+    and BigInt::ToDecimal()), and returns the number of characters written.
+  */
+  size_t ToHex(gsl::span<char> out) const { return ToStandardForm().ToHex(out); }
+  size_t ToDecimal(gsl::span<char> out) const { return ToStandardForm().ToDecimal(out); }
+
   std::string ToString() const { return ToStandardForm().ToString(); }
 
  private:
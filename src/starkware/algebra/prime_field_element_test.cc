@@ -1,7 +1,13 @@
 #include "starkware/algebra/prime_field_element.h"
 
+#include <array>
+#include <string>
+
+#include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
+#include "starkware/utils/test_utils.h"
+
 namespace starkware {
 namespace {
 
@@ -42,6 +48,50 @@ TEST(PrimeField, Random) {
   }
 }
 
+TEST(PrimeFieldElementTest, MontgomeryForm) {
+  EXPECT_EQ(PrimeFieldElement::One().ToMontgomeryForm(), PrimeFieldElement::kMontgomeryR);
+  EXPECT_EQ(PrimeFieldElement::FromMontgomeryForm(PrimeFieldElement::kMontgomeryR),
+            PrimeFieldElement::One());
+
+  Prng prng;
+  const auto a = PrimeFieldElement::RandomElement(&prng);
+  EXPECT_EQ(PrimeFieldElement::FromMontgomeryForm(a.ToMontgomeryForm()), a);
+  EXPECT_EQ(
+      a.ToMontgomeryForm(),
+      PrimeFieldElement::ValueType::MulMod(
+          a.ToStandardForm(), PrimeFieldElement::kMontgomeryR, PrimeFieldElement::kModulus));
+  EXPECT_ASSERT(
+      PrimeFieldElement::FromMontgomeryForm(PrimeFieldElement::kModulus),
+      testing::HasSubstr("out of range"));
+}
+
+TEST(PrimeFieldElementTest, FromHexAndDecimal) {
+  EXPECT_EQ(PrimeFieldElement::FromHex("0x1"), PrimeFieldElement::One());
+  EXPECT_EQ(PrimeFieldElement::FromDecimal("1"), PrimeFieldElement::One());
+  // Values that are not smaller than the prime are reduced.
+  EXPECT_EQ(
+      PrimeFieldElement::FromHex(
+          "0x800000000000011000000000000000000000000000000000000000000000002"),
+      PrimeFieldElement::One());
+  EXPECT_EQ(
+      PrimeFieldElement::FromDecimal(
+          "3618502788666131213697322783095070105623107215331596699973092056135872020481"),
+      PrimeFieldElement::Zero());
+  EXPECT_EQ(
+      PrimeFieldElement::FromHex(
+          "0xffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff"),
+      PrimeFieldElement::FromHex(
+          "0x7fffffffffffdf0ffffffffffffffffffffffffffffffffffffffffffffffe0"));
+
+  Prng prng;
+  const auto a = PrimeFieldElement::RandomElement(&prng);
+  std::array<char, PrimeFieldElement::ValueType::kMaxDecimalSize> out{};
+  EXPECT_EQ(a.ToHex(out), PrimeFieldElement::ValueType::kHexSize);
+  EXPECT_EQ(std::string(out.data(), PrimeFieldElement::ValueType::kHexSize), a.ToString());
+  EXPECT_EQ(PrimeFieldElement::FromHex(std::string_view(out.data(), a.ToHex(out))), a);
+  EXPECT_EQ(PrimeFieldElement::FromDecimal(std::string_view(out.data(), a.ToDecimal(out))), a);
+}
+
 TEST(PrimeFieldElementTest, Inv) {
   auto a = PrimeFieldElement::One();
   auto z = PrimeFieldElement::Zero();
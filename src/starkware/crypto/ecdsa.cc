@@ -1,24 +1,200 @@
 #include "starkware/crypto/ecdsa.h"
 
+#include <optional>
+
 #include "starkware/algebra/fraction_field_element.h"
 #include "starkware/crypto/elliptic_curve_constants.h"
+#include "starkware/crypto/rfc6979.h"
 #include "starkware/utils/error_handling.h"
 #include "starkware/utils/prng.h"
 
 namespace starkware {
 
+namespace {
+
+using ValueType = PrimeFieldElement::ValueType;
+using FractionFieldElementT = FractionFieldElement<PrimeFieldElement>;
+using FractionEcPointT = EcPoint<FractionFieldElementT>;
+
+// The minimal number of requests per thread in VerifyEcdsaParallel(). Verifying a signature takes
+// far longer than starting a thread, so a small number suffices.
+constexpr size_t kMinVerificationsPerThread = 4;
+
+// The minimal number of keys per thread in GetPublicKeysBatch(), so that the inversion of each
+// thread is shared by enough keys.
+constexpr size_t kMinKeysPerThread = 64;
+
+/*
+  Returns true if public_key is on the curve.
+*/
+bool IsOnCurve(const EcPoint<PrimeFieldElement>& public_key) {
+  const auto& [x, y] = public_key;
+  return y * y == x * (x * x + GetEcConstants().k_alpha) + GetEcConstants().k_beta;
+}
+
+/*
+  Returns the inverses of values modulo prime, using a single inversion (Montgomery's trick). All
+  the values must be nonzero modulo prime.
+*/
+std::vector<ValueType> BatchInverseModPrime(
+    gsl::span<const ValueType> values, const ValueType& prime) {
+  if (values.empty()) {
+    return {};
+  }
+  // prefix_products[i] is the product of values[0], ..., values[i].
+  std::vector<ValueType> prefix_products;
+  prefix_products.reserve(values.size());
+  prefix_products.push_back(values[0]);
+  for (size_t i = 1; i < values.size(); ++i) {
+    prefix_products.push_back(ValueType::MulMod(prefix_products.back(), values[i], prime));
+  }
+
+  std::vector<ValueType> inverses(values.size());
+  // Holds the inverse of the product of values[0], ..., values[i].
+  ValueType inverse = prefix_products.back().InvModPrime(prime);
+  for (size_t i = values.size() - 1; i > 0; --i) {
+    inverses[i] = ValueType::MulMod(inverse, prefix_products[i - 1], prime);
+    inverse = ValueType::MulMod(inverse, values[i], prime);
+  }
+  inverses[0] = inverse;
+  return inverses;
+}
+
+/*
+  Returns the status of the ranges of z, r and w: all must be in the range [1, 2^251).
+*/
+VerifyStatus CheckVerificationInput(const PrimeFieldElement& z, const Signature& sig) {
+  const auto upper_bound = 0x800000000000000000000000000000000000000000000000000000000000000_Z;
+  if (z == PrimeFieldElement::Zero() || z.ToStandardForm() >= upper_bound) {
+    return VerifyStatus::kInvalidMessage;
+  }
+  for (const PrimeFieldElement& value : {sig.first, sig.second}) {
+    if (value == PrimeFieldElement::Zero() || value.ToStandardForm() >= upper_bound) {
+      return VerifyStatus::kSignatureOutOfRange;
+    }
+  }
+  return VerifyStatus::kValid;
+}
+
+/*
+  Returns (z * w, r * w) modulo the order of the curve, for inputs that passed
+  CheckVerificationInput(). Both are nonzero, since the order is a prime larger than 2^251.
+*/
+std::pair<ValueType, ValueType> ComputeVerificationScalars(
+    const PrimeFieldElement& z, const Signature& sig) {
+  const ValueType w_standard = sig.second.ToStandardForm();
+  return {ValueType::MulMod(z.ToStandardForm(), w_standard, GetEcConstants().k_order),
+          ValueType::MulMod(sig.first.ToStandardForm(), w_standard, GetEcConstants().k_order)};
+}
+
+/*
+  Checks the inputs of VerifyEcdsa(), and returns (z * w, r * w) modulo the order of the curve.
+*/
+std::pair<ValueType, ValueType> GetVerificationScalars(
+    const PrimeFieldElement& z, const Signature& sig) {
+  const auto& r = sig.first;
+  const auto& w = sig.second;
+  // z, r, w should be smaller than 2^251.
+  const auto upper_bound = 0x800000000000000000000000000000000000000000000000000000000000000_Z;
+  ASSERT(z != PrimeFieldElement::Zero(), "Message cannot be zero.");
+  ASSERT(z.ToStandardForm() < upper_bound, "z is too big.");
+  ASSERT(r != PrimeFieldElement::Zero(), "r cannot be zero.");
+  ASSERT(r.ToStandardForm() < upper_bound, "r is too big.");
+  ASSERT(w != PrimeFieldElement::Zero(), "w cannot be zero.");
+  ASSERT(w.ToStandardForm() < upper_bound, "w is too big.");
+  return ComputeVerificationScalars(z, sig);
+}
+
+/*
+  Returns scalar * G, where scalar is a nonzero number smaller than the order of the curve.
+*/
+FractionEcPointT MultiplyGenerator(const ValueType& scalar) {
+  const std::optional<FractionEcPointT> res = GetGeneratorTable().Multiply(scalar);
+  ASSERT(res.has_value(), "Result of multiplication is the curve's zero element.");
+  return *res;
+}
+
+/*
+  Returns (scalar * G).x, where scalar * G is not the zero element.
+*/
+PrimeFieldElement MultiplyGeneratorXOnly(const ValueType& scalar) {
+  const std::optional<PrimeFieldElement> res = EcPoint<PrimeFieldElement>::MultiplyXOnly(
+      GetEcConstants().k_points[1].x, scalar, GetEcConstants().k_alpha, GetEcConstants().k_beta);
+  ASSERT(res.has_value(), "Result of multiplication is the curve's zero element.");
+  return *res;
+}
+
+/*
+  Returns true if the signature whose first component is r is valid for zw_g = z * w * G and
+  rw_q = r * w * Q, for either Q or -Q.
+*/
+bool IsValidCombination(
+    const FractionEcPointT& zw_g, const FractionEcPointT& rw_q, const PrimeFieldElement& r) {
+  if (zw_g.x == rw_q.x) {
+    // rw_q = zw_g or rw_q = -zw_g. One of the combinations is the zero element, which has no x
+    // coordinate, and the other is zw_g + zw_g or -(zw_g + zw_g).
+    const FractionFieldElementT alpha(GetEcConstants().k_alpha);
+    return zw_g.Double(alpha).x.ToBaseFieldElement() == r;
+  }
+  return (zw_g + rw_q).x.ToBaseFieldElement() == r || (zw_g - rw_q).x.ToBaseFieldElement() == r;
+}
+
+/*
+  Returns true if the signature whose first component is r is valid for z * w = zw and r * w = rw,
+  with either public_key or -public_key.
+*/
+bool IsValidSignature(
+    const EcPoint<PrimeFieldElement>& public_key, const ValueType& zw, const ValueType& rw,
+    const PrimeFieldElement& r) {
+  const FractionFieldElementT alpha(GetEcConstants().k_alpha);
+  const FractionEcPointT rw_q =
+      public_key.ConvertTo<FractionFieldElementT>().MultiplyByScalar(rw, alpha);
+  return IsValidCombination(MultiplyGenerator(zw), rw_q, r);
+}
+
+}  // namespace
+
 EcPoint<PrimeFieldElement> GetPublicKey(const PrimeFieldElement::ValueType& private_key) {
   const auto& generator = GetEcConstants().k_points[1];
   const auto& alpha = GetEcConstants().k_alpha;
   return generator.MultiplyByScalar(private_key, alpha);
 }
 
+PrimeFieldElement GetStarkKey(const PrimeFieldElement::ValueType& private_key) {
+  return MultiplyGeneratorXOnly(private_key);
+}
+
+std::vector<EcPoint<PrimeFieldElement>> GetPublicKeysBatch(
+    gsl::span<const ValueType> private_keys, size_t n_threads) {
+  std::vector<EcPoint<PrimeFieldElement>> public_keys(
+      private_keys.size(), {PrimeFieldElement::Zero(), PrimeFieldElement::Zero()});
+  ParallelFor(
+      private_keys.size(), n_threads,
+      [&](size_t begin, size_t end) {
+        const size_t n_keys = end - begin;
+        // The x coordinates of the chunk, followed by its y coordinates.
+        std::vector<FractionFieldElementT> fraction_coordinates(
+            2 * n_keys, FractionFieldElementT::Zero());
+        for (size_t i = 0; i < n_keys; ++i) {
+          const FractionEcPointT public_key = MultiplyGenerator(private_keys[begin + i]);
+          fraction_coordinates[i] = public_key.x;
+          fraction_coordinates[n_keys + i] = public_key.y;
+        }
+        std::vector<PrimeFieldElement> coordinates(
+            fraction_coordinates.size(), PrimeFieldElement::Zero());
+        FractionFieldElementT::BatchToBaseFieldElement(fraction_coordinates, coordinates);
+        for (size_t i = 0; i < n_keys; ++i) {
+          public_keys[begin + i] = {coordinates[i], coordinates[n_keys + i]};
+        }
+      },
+      kMinKeysPerThread);
+  return public_keys;
+}
+
 Signature SignEcdsa(
     const PrimeFieldElement::ValueType& private_key, const PrimeFieldElement& z,
     const PrimeFieldElement::ValueType& k) {
   using ValueType = typename PrimeFieldElement::ValueType;
-  const auto& generator = GetEcConstants().k_points[1];
-  const auto& alpha = GetEcConstants().k_alpha;
   const auto& curve_order = GetEcConstants().k_order;
   constexpr auto upper_bound = 0x800000000000000000000000000000000000000000000000000000000000000_Z;
   static_assert(upper_bound <= PrimeFieldElement::kModulus);
@@ -28,7 +204,7 @@ Signature SignEcdsa(
   ASSERT(z.ToStandardForm() < upper_bound, "z is too big.");
   ASSERT(k != ValueType::Zero(), "k must not be zero");
 
-  const PrimeFieldElement x = generator.MultiplyByScalar(k, alpha).x;
+  const PrimeFieldElement x = MultiplyGeneratorXOnly(k);
   const ValueType r = x.ToStandardForm();
   ASSERT(
       (r < curve_order) && (r != ValueType::Zero()),
@@ -42,36 +218,108 @@ Signature SignEcdsa(
   s = ValueType::MulMod(s, k_inv, curve_order);
   ASSERT(s != ValueType::Zero(), "Bad randomness, please try a different k.");
 
-  const ValueType w = s.InvModPrime(curve_order);
+  // s is part of the signature, so it may be inverted in variable time, unlike k.
+  const ValueType w = s.InvModPrimeVariableTime(curve_order);
   ASSERT(w < upper_bound, "Bad randomness, please try a different k.");
   const PrimeFieldElement w_field = PrimeFieldElement::FromBigInt(w);
   return {x, w_field};
 }
 
+Signature SignEcdsaDeterministic(
+    const ValueType& private_key, const PrimeFieldElement& z, std::optional<uint64_t> seed) {
+  const auto& curve_order = GetEcConstants().k_order;
+  constexpr auto upper_bound = 0x800000000000000000000000000000000000000000000000000000000000000_Z;
+  ASSERT(z != PrimeFieldElement::Zero(), "Message cannot be zero.");
+  ASSERT(z.ToStandardForm() < upper_bound, "z is too big.");
+
+  while (true) {
+    const ValueType k = GenerateKRfc6979(z.ToStandardForm(), private_key, seed);
+    seed = seed.has_value() ? *seed + 1 : 1;
+
+    // k is in the range [1, curve_order), so k * G is not the zero element.
+    const PrimeFieldElement x = MultiplyGeneratorXOnly(k);
+    const ValueType r = x.ToStandardForm();
+    if (r == ValueType::Zero() || r >= upper_bound) {
+      continue;
+    }
+    // Both summands are smaller than curve_order, so the sum is smaller than 2 * curve_order.
+    const ValueType denominator = ValueType::ReduceIfNeeded(
+        ValueType::MulMod(r, private_key, curve_order) + z.ToStandardForm(), curve_order);
+    if (denominator == ValueType::Zero()) {
+      continue;
+    }
+    // w = s^-1 = k / (z + r * private_key).
+    const ValueType w = ValueType::MulMod(k, denominator.InvModPrime(curve_order), curve_order);
+    if (w < upper_bound) {
+      return {x, PrimeFieldElement::FromBigInt(w)};
+    }
+  }
+}
+
+std::vector<Signature> SignEcdsaBatch(
+    gsl::span<const ValueType> private_keys, gsl::span<const PrimeFieldElement> msgs,
+    gsl::span<const ValueType> ks) {
+  const auto& curve_order = GetEcConstants().k_order;
+  constexpr auto upper_bound = 0x800000000000000000000000000000000000000000000000000000000000000_Z;
+  static_assert(upper_bound <= PrimeFieldElement::kModulus);
+  ASSERT(upper_bound <= curve_order, "Unexpected curve size.");
+  ASSERT(
+      private_keys.size() == msgs.size() && ks.size() == msgs.size(),
+      "Number of private keys, messages and nonces mismatch.");
+  const size_t n_sigs = msgs.size();
+
+  std::vector<FractionFieldElementT> fraction_xs;
+  fraction_xs.reserve(n_sigs);
+  for (size_t i = 0; i < n_sigs; ++i) {
+    ASSERT(msgs[i] != PrimeFieldElement::Zero(), "Message cannot be zero.");
+    ASSERT(msgs[i].ToStandardForm() < upper_bound, "z is too big.");
+    ASSERT(ks[i] != ValueType::Zero(), "k must not be zero");
+    fraction_xs.push_back(MultiplyGenerator(ks[i]).x);
+  }
+  std::vector<PrimeFieldElement> xs(n_sigs, PrimeFieldElement::Zero());
+  FractionFieldElementT::BatchToBaseFieldElement(fraction_xs, xs);
+
+  // s = (z + r * private_key) / k, so w = k / (z + r * private_key).
+  std::vector<ValueType> denominators;
+  denominators.reserve(n_sigs);
+  for (size_t i = 0; i < n_sigs; ++i) {
+    const ValueType r = xs[i].ToStandardForm();
+    ASSERT(
+        (r < curve_order) && (r != ValueType::Zero()),
+        "Bad randomness, please try a different a different k.");
+    // Both summands are smaller than curve_order, so the sum is smaller than 2 * curve_order.
+    const ValueType denominator = ValueType::ReduceIfNeeded(
+        ValueType::MulMod(r, private_keys[i], curve_order) + msgs[i].ToStandardForm(),
+        curve_order);
+    ASSERT(denominator != ValueType::Zero(), "Bad randomness, please try a different k.");
+    denominators.push_back(denominator);
+  }
+  const std::vector<ValueType> denominator_inverses =
+      BatchInverseModPrime(denominators, curve_order);
+
+  std::vector<Signature> sigs;
+  sigs.reserve(n_sigs);
+  for (size_t i = 0; i < n_sigs; ++i) {
+    const ValueType w = ValueType::MulMod(ks[i], denominator_inverses[i], curve_order);
+    ASSERT(w < upper_bound, "Bad randomness, please try a different k.");
+    sigs.emplace_back(xs[i], PrimeFieldElement::FromBigInt(w));
+  }
+  return sigs;
+}
+
 bool VerifyEcdsa(
     const EcPoint<PrimeFieldElement>& public_key, const PrimeFieldElement& z,
     const Signature& sig) {
-  using FractionFieldElementT = FractionFieldElement<PrimeFieldElement>;
-  using EcPointT = EcPoint<FractionFieldElementT>;
-  const auto& r = sig.first;
-  const auto& w = sig.second;
-  // z, r, w should be smaller than 2^251.
-  const auto upper_bound = 0x800000000000000000000000000000000000000000000000000000000000000_Z;
-  ASSERT(z != PrimeFieldElement::Zero(), "Message cannot be zero.");
-  ASSERT(z.ToStandardForm() < upper_bound, "z is too big.");
-  ASSERT(r != PrimeFieldElement::Zero(), "r cannot be zero.");
-  ASSERT(r.ToStandardForm() < upper_bound, "r is too big.");
-  ASSERT(w != PrimeFieldElement::Zero(), "w cannot be zero.");
-  ASSERT(w.ToStandardForm() < upper_bound, "w is too big.");
-  const FractionFieldElementT alpha(GetEcConstants().k_alpha);
-  const auto generator = GetEcConstants().k_points[1];
-  const auto zw = PrimeFieldElement::ValueType::MulMod(
-      z.ToStandardForm(), w.ToStandardForm(), GetEcConstants().k_order);
-  const EcPointT zw_g = generator.ConvertTo<FractionFieldElementT>().MultiplyByScalar(zw, alpha);
-  const auto rw = PrimeFieldElement::ValueType::MulMod(
-      r.ToStandardForm(), w.ToStandardForm(), GetEcConstants().k_order);
-  const EcPointT rw_q = public_key.ConvertTo<FractionFieldElementT>().MultiplyByScalar(rw, alpha);
-  return (zw_g + rw_q).x.ToBaseFieldElement() == r || (zw_g - rw_q).x.ToBaseFieldElement() == r;
+  const auto [zw, rw] = GetVerificationScalars(z, sig);
+  return IsValidSignature(public_key, zw, rw, sig.first);
+}
+
+bool VerifyEcdsa(
+    const PreparedPublicKey& public_key, const PrimeFieldElement& z, const Signature& sig) {
+  const auto [zw, rw] = GetVerificationScalars(z, sig);
+  const std::optional<FractionEcPointT> rw_q = public_key.Table().Multiply(rw);
+  ASSERT(rw_q.has_value(), "Result of multiplication is the curve's zero element.");
+  return IsValidCombination(MultiplyGenerator(zw), *rw_q, sig.first);
 }
 
 bool VerifyEcdsaPartialKey(
@@ -88,4 +336,51 @@ bool VerifyEcdsaPartialKey(
   return VerifyEcdsa(*public_key, z, sig);
 }
 
+VerifyStatus VerifyEcdsaChecked(
+    const EcPoint<PrimeFieldElement>& public_key, const PrimeFieldElement& z,
+    const Signature& sig) {
+  const VerifyStatus input_status = CheckVerificationInput(z, sig);
+  if (input_status != VerifyStatus::kValid) {
+    return input_status;
+  }
+  if (!IsOnCurve(public_key)) {
+    return VerifyStatus::kInvalidPublicKey;
+  }
+  const auto [zw, rw] = ComputeVerificationScalars(z, sig);
+  return IsValidSignature(public_key, zw, rw, sig.first) ? VerifyStatus::kValid
+                                                         : VerifyStatus::kInvalidSignature;
+}
+
+VerifyStatus VerifyEcdsaPartialKeyChecked(
+    const PrimeFieldElement& public_key_x, const PrimeFieldElement& z, const Signature& sig) {
+  const VerifyStatus input_status = CheckVerificationInput(z, sig);
+  if (input_status != VerifyStatus::kValid) {
+    return input_status;
+  }
+  const auto public_key = EcPoint<PrimeFieldElement>::GetPointFromX(
+      public_key_x, GetEcConstants().k_alpha, GetEcConstants().k_beta);
+  if (!public_key.has_value()) {
+    return VerifyStatus::kInvalidPublicKey;
+  }
+  const auto [zw, rw] = ComputeVerificationScalars(z, sig);
+  return IsValidSignature(*public_key, zw, rw, sig.first) ? VerifyStatus::kValid
+                                                          : VerifyStatus::kInvalidSignature;
+}
+
+void VerifyEcdsaParallel(
+    gsl::span<const VerifyRequest> requests, gsl::span<uint8_t> results, size_t n_threads) {
+  ASSERT(results.size() == requests.size(), "Number of requests and results mismatch.");
+  ParallelFor(
+      requests.size(), n_threads,
+      [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+          const VerifyRequest& request = requests[i];
+          results[i] = static_cast<uint8_t>(
+              VerifyEcdsaPartialKeyChecked(request.public_key_x, request.z, request.sig) ==
+              VerifyStatus::kValid);
+        }
+      },
+      kMinVerificationsPerThread);
+}
+
 }  // namespace starkware
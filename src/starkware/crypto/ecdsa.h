@@ -1,10 +1,18 @@
 #ifndef STARKWARE_CRYPTO_ECDSA_H_
 #define STARKWARE_CRYPTO_ECDSA_H_
 
+#include <cstddef>
+#include <cstdint>
+#include <optional>
 #include <utility>
+#include <vector>
+
+#include "third_party/gsl/gsl-lite.hpp"
 
 #include "starkware/algebra/elliptic_curve.h"
 #include "starkware/algebra/prime_field_element.h"
+#include "starkware/crypto/fixed_base_table.h"
+#include "starkware/utils/parallel.h"
 
 namespace starkware {
 
@@ -13,6 +21,31 @@ namespace starkware {
 */
 using Signature = std::pair<PrimeFieldElement, PrimeFieldElement>;
 
+/*
+  A request to verify the signature sig of the message hash z with the partial public key
+  public_key_x (see VerifyEcdsaPartialKey()).
+*/
+struct VerifyRequest {
+  PrimeFieldElement public_key_x;
+  PrimeFieldElement z;
+  Signature sig;
+};
+
+/*
+  The result of VerifyEcdsaChecked() and VerifyEcdsaPartialKeyChecked().
+*/
+enum class VerifyStatus {
+  kValid = 0,
+  // The input is well formed, but the signature does not match it.
+  kInvalidSignature,
+  // z is zero or not smaller than 2^251.
+  kInvalidMessage,
+  // r or w is zero or not smaller than 2^251.
+  kSignatureOutOfRange,
+  // The public key is not a point on the curve.
+  kInvalidPublicKey,
+};
+
 /*
   Deduces the public key given a private key.
   The x coordinate of the public key is also known as the partial public key,
@@ -20,6 +53,23 @@ using Signature = std::pair<PrimeFieldElement, PrimeFieldElement>;
 */
 EcPoint<PrimeFieldElement> GetPublicKey(const PrimeFieldElement::ValueType& private_key);
 
+/*
+  Returns the x coordinate of GetPublicKey(private_key), i.e. the partial public key. Only the x
+  coordinate is computed (see EcPoint::MultiplyXOnly()), which is considerably faster.
+*/
+PrimeFieldElement GetStarkKey(const PrimeFieldElement::ValueType& private_key);
+
+/*
+  Returns GetPublicKey(private_keys[i]) for every i.
+
+  The keys are split between n_threads threads (see ParallelFor()). Every thread multiplies the
+  generator using its table (see GetGeneratorTable()), in fraction field coordinates, and converts
+  all its results to affine coordinates with a single inversion.
+*/
+std::vector<EcPoint<PrimeFieldElement>> GetPublicKeysBatch(
+    gsl::span<const PrimeFieldElement::ValueType> private_keys,
+    size_t n_threads = GetNumHardwareThreads());
+
 /*
   Signs message hash z with the provided private_key, with randomness k.
 
@@ -30,6 +80,29 @@ Signature SignEcdsa(
     const PrimeFieldElement::ValueType& private_key, const PrimeFieldElement& z,
     const PrimeFieldElement::ValueType& k);
 
+/*
+  Signs message hash z with the provided private_key, with a nonce k derived from them as in RFC
+  6979 (see GenerateKRfc6979()). A nonce that yields an invalid signature (r or w that is zero or
+  not smaller than 2^251, or s == 0) is replaced by the next one, generated with seed 1, 2, ...
+
+  The result is the same as that of sign() in StarkWare's Python library with the same seed.
+*/
+Signature SignEcdsaDeterministic(
+    const PrimeFieldElement::ValueType& private_key, const PrimeFieldElement& z,
+    std::optional<uint64_t> seed = std::nullopt);
+
+/*
+  Signs msgs[i] with private_keys[i], with randomness ks[i], for every i. Returns the same
+  signatures as SignEcdsa(), and throws if SignEcdsa() would throw for any of them.
+
+  All the points k_i * G are computed with the table of the generator (see GetGeneratorTable()) and
+  normalized together, and all the inversions modulo the order of the curve are replaced by a
+  single one (Montgomery's trick). Since w = s^-1 = k / (z + r * private_key), k^-1 is not needed.
+*/
+std::vector<Signature> SignEcdsaBatch(
+    gsl::span<const PrimeFieldElement::ValueType> private_keys,
+    gsl::span<const PrimeFieldElement> msgs, gsl::span<const PrimeFieldElement::ValueType> ks);
+
 /*
   Verifies ECDSA signature of a given hash message z with a given public key.
   Returns true if either public_key or -public_key signs the message.
@@ -38,6 +111,12 @@ Signature SignEcdsa(
 bool VerifyEcdsa(
     const EcPoint<PrimeFieldElement>& public_key, const PrimeFieldElement& z, const Signature& sig);
 
+/*
+  Same as VerifyEcdsa(), for a public key with a precomputed table.
+*/
+bool VerifyEcdsa(
+    const PreparedPublicKey& public_key, const PrimeFieldElement& z, const Signature& sig);
+
 /*
   Same as VerifyEcdsa() except that only the x coordinate of the public key is given. The y
   coordinate is computed, and both options are checked.
@@ -45,6 +124,30 @@ bool VerifyEcdsa(
 bool VerifyEcdsaPartialKey(
     const PrimeFieldElement& public_key_x, const PrimeFieldElement& z, const Signature& sig);
 
+/*
+  Same as VerifyEcdsa() and VerifyEcdsaPartialKey(), except that invalid input is reported by the
+  returned status instead of by throwing. The input is validated with plain comparisons before
+  any curve arithmetic, so rejecting it is cheap. VerifyEcdsaChecked() also checks that public_key
+  is on the curve.
+*/
+VerifyStatus VerifyEcdsaChecked(
+    const EcPoint<PrimeFieldElement>& public_key, const PrimeFieldElement& z, const Signature& sig);
+
+VerifyStatus VerifyEcdsaPartialKeyChecked(
+    const PrimeFieldElement& public_key_x, const PrimeFieldElement& z, const Signature& sig);
+
+/*
+  Verifies every request with VerifyEcdsaPartialKey(), and sets results[i] to 1 if requests[i] is
+  valid and to 0 otherwise. Invalid input (e.g., a public key that is not on the curve) fails the
+  request instead of throwing.
+
+  The requests are independent, so they are split evenly between n_threads threads (see
+  ParallelFor()), and the throughput grows about linearly with the number of cores.
+*/
+void VerifyEcdsaParallel(
+    gsl::span<const VerifyRequest> requests, gsl::span<uint8_t> results,
+    size_t n_threads = GetNumHardwareThreads());
+
 }  // namespace starkware
 
 #endif  // STARKWARE_CRYPTO_ECDSA_H_
@@ -1,14 +1,20 @@
 #include "starkware/crypto/ecdsa.h"
 
+#include <vector>
+
+#include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
 #include "starkware/algebra/elliptic_curve.h"
 #include "starkware/algebra/prime_field_element.h"
 #include "starkware/crypto/elliptic_curve_constants.h"
+#include "starkware/utils/test_utils.h"
 
 namespace starkware {
 namespace {
 
+using testing::HasSubstr;
+
 TEST(ECDSA, PublicKeyFromPrivate) {
   const auto private_key = 0x3c1e9550e66958296d11b60f8e8e7a7ad990d07fa65d5f7652c4a6c87d4e3cc_Z;
   const EcPoint<PrimeFieldElement> public_key(
@@ -20,6 +26,42 @@ TEST(ECDSA, PublicKeyFromPrivate) {
   EXPECT_EQ(public_key, GetPublicKey(private_key));
 }
 
+TEST(ECDSA, StarkKey) {
+  Prng prng;
+  using ValueType = PrimeFieldElement::ValueType;
+  const auto& curve_order = GetEcConstants().k_order;
+  for (const ValueType& private_key :
+       {0x3c1e9550e66958296d11b60f8e8e7a7ad990d07fa65d5f7652c4a6c87d4e3cc_Z, ValueType::One(),
+        curve_order - ValueType::One(), curve_order + ValueType(5),
+        ValueType::RandomBigInt(&prng)}) {
+    EXPECT_EQ(GetStarkKey(private_key), GetPublicKey(private_key).x);
+  }
+  EXPECT_ASSERT(GetStarkKey(ValueType::Zero()), HasSubstr("zero element"));
+  EXPECT_ASSERT(GetStarkKey(curve_order), HasSubstr("zero element"));
+}
+
+TEST(ECDSA, GetPublicKeysBatch) {
+  Prng prng;
+  using ValueType = PrimeFieldElement::ValueType;
+  std::vector<ValueType> private_keys;
+  for (size_t i = 0; i < 150; ++i) {
+    private_keys.push_back(ValueType::RandomBigInt(&prng));
+  }
+  private_keys[3] = ValueType::One();
+  private_keys[7] = GetEcConstants().k_order + ValueType(2);
+
+  for (size_t n_threads : {1, 2}) {
+    const auto public_keys = GetPublicKeysBatch(private_keys, n_threads);
+    ASSERT_EQ(public_keys.size(), private_keys.size());
+    for (size_t i = 0; i < private_keys.size(); i += 7) {
+      EXPECT_EQ(public_keys[i], GetPublicKey(private_keys[i]));
+    }
+  }
+  EXPECT_TRUE(GetPublicKeysBatch({}).empty());
+  private_keys[100] = GetEcConstants().k_order;
+  EXPECT_ASSERT(GetPublicKeysBatch(private_keys, 2), HasSubstr("zero element"));
+}
+
 TEST(ECDSA, SignAndVerify) {
   Prng prng;
   using ValueType = PrimeFieldElement::ValueType;
@@ -35,6 +77,46 @@ TEST(ECDSA, SignAndVerify) {
   EXPECT_TRUE(VerifyEcdsa(public_key, msg, signature));
 }
 
+TEST(SignEcdsaBatch, CompareToSignEcdsa) {
+  Prng prng;
+  using ValueType = PrimeFieldElement::ValueType;
+  const auto& curve_order = GetEcConstants().k_order;
+  const auto upper_bound = 0x800000000000000000000000000000000000000000000000000000000000000_Z;
+
+  std::vector<ValueType> private_keys;
+  std::vector<PrimeFieldElement> msgs;
+  std::vector<ValueType> ks;
+  for (size_t i = 0; i < 3; ++i) {
+    private_keys.push_back(ValueType::RandomBigInt(&prng));
+    msgs.push_back(
+        PrimeFieldElement::FromBigInt(ValueType::RandomBigInt(&prng).Div(upper_bound).second));
+    ks.push_back(ValueType::RandomBigInt(&prng));
+  }
+  const std::vector<Signature> sigs = SignEcdsaBatch(private_keys, msgs, ks);
+  ASSERT_EQ(sigs.size(), 3U);
+  for (size_t i = 0; i < sigs.size(); ++i) {
+    EXPECT_EQ(sigs[i], SignEcdsa(private_keys[i], msgs[i], ks[i]));
+  }
+  EXPECT_TRUE(SignEcdsaBatch({}, {}, {}).empty());
+
+  // The errors of SignEcdsa().
+  auto bad_msgs = msgs;
+  bad_msgs[1] = PrimeFieldElement::Zero();
+  EXPECT_ASSERT(SignEcdsaBatch(private_keys, bad_msgs, ks), HasSubstr("Message cannot be zero"));
+  auto bad_ks = ks;
+  bad_ks[2] = ValueType::Zero();
+  EXPECT_ASSERT(SignEcdsaBatch(private_keys, msgs, bad_ks), HasSubstr("k must not be zero"));
+  // Choose z such that s = (z + r * private_key) / k is zero.
+  const ValueType r = sigs[0].first.ToStandardForm();
+  const ValueType z = curve_order - ValueType::MulMod(r, private_keys[0], curve_order);
+  ASSERT_LT(z, upper_bound);
+  bad_msgs = msgs;
+  bad_msgs[0] = PrimeFieldElement::FromBigInt(z);
+  EXPECT_ASSERT(SignEcdsaBatch(private_keys, bad_msgs, ks), HasSubstr("Bad randomness"));
+  EXPECT_ASSERT(
+      SignEcdsaBatch(private_keys, gsl::make_span(msgs).first(2), ks), HasSubstr("mismatch"));
+}
+
 TEST(VerifyEcdsa, Regression) {
   Prng prng;
   const auto alpha = GetEcConstants().k_alpha;
@@ -72,6 +154,122 @@ TEST(VerifyEcdsa, Regression) {
   EXPECT_FALSE(VerifyEcdsaPartialKey(public_key_y, z, {r, w}));
 }
 
+TEST(VerifyEcdsaChecked, Statuses) {
+  const auto alpha = GetEcConstants().k_alpha;
+  const auto beta = GetEcConstants().k_beta;
+  // The values of the VerifyEcdsa.Regression test.
+  const auto public_key_x = PrimeFieldElement::FromBigInt(
+      0x77a3b314db07c45076d11f62b6f9e748a39790441823307743cf00d6597ea43_Z);
+  const auto public_key_y = PrimeFieldElement::FromBigInt(
+      0x54d7beec5ec728223671c627557efc5c9a6508425dc6c900b7741bf60afec06_Z);
+  const EcPoint<PrimeFieldElement> public_key(public_key_x, public_key_y);
+  const auto z = PrimeFieldElement::FromBigInt(
+      0x397e76d1667c4454bfb83514e120583af836f8e32a516765497823eabe16a3f_Z);
+  const auto r = PrimeFieldElement::FromBigInt(
+      0x173fd03d8b008ee7432977ac27d1e9d1a1f6c98b1a2f05fa84a21c84c44e882_Z);
+  const auto w = PrimeFieldElement::FromBigInt(
+      0x1f2c44a7798f55192f153b4c48ea5c1241fbb69e6132cc8a0da9c5b62a4286e_Z);
+  const auto zero = PrimeFieldElement::Zero();
+  const auto too_big = PrimeFieldElement::FromBigInt(
+      0x800000000000000000000000000000000000000000000000000000000000000_Z);
+
+  EXPECT_EQ(VerifyEcdsaChecked(public_key, z, {r, w}), VerifyStatus::kValid);
+  EXPECT_EQ(VerifyEcdsaChecked(-public_key, z, {r, w}), VerifyStatus::kValid);
+  EXPECT_EQ(
+      VerifyEcdsaChecked(public_key, z + PrimeFieldElement::One(), {r, w}),
+      VerifyStatus::kInvalidSignature);
+  EXPECT_EQ(VerifyEcdsaChecked(public_key, zero, {r, w}), VerifyStatus::kInvalidMessage);
+  EXPECT_EQ(VerifyEcdsaChecked(public_key, too_big, {r, w}), VerifyStatus::kInvalidMessage);
+  EXPECT_EQ(VerifyEcdsaChecked(public_key, z, {zero, w}), VerifyStatus::kSignatureOutOfRange);
+  EXPECT_EQ(VerifyEcdsaChecked(public_key, z, {r, too_big}), VerifyStatus::kSignatureOutOfRange);
+  EXPECT_EQ(
+      VerifyEcdsaChecked({public_key_x, public_key_y + PrimeFieldElement::One()}, z, {r, w}),
+      VerifyStatus::kInvalidPublicKey);
+
+  PrimeFieldElement invalid_x = PrimeFieldElement::One();
+  while (EcPoint<PrimeFieldElement>::GetPointFromX(invalid_x, alpha, beta).has_value()) {
+    invalid_x = invalid_x + PrimeFieldElement::One();
+  }
+  EXPECT_EQ(VerifyEcdsaPartialKeyChecked(public_key_x, z, {r, w}), VerifyStatus::kValid);
+  EXPECT_EQ(
+      VerifyEcdsaPartialKeyChecked(public_key_x, z, {r, w + PrimeFieldElement::One()}),
+      VerifyStatus::kInvalidSignature);
+  EXPECT_EQ(
+      VerifyEcdsaPartialKeyChecked(invalid_x, z, {r, w}), VerifyStatus::kInvalidPublicKey);
+  EXPECT_EQ(
+      VerifyEcdsaPartialKeyChecked(invalid_x, zero, {r, w}), VerifyStatus::kInvalidMessage);
+}
+
+TEST(VerifyEcdsa, EqualCombinationPoints) {
+  using ValueType = PrimeFieldElement::ValueType;
+  // With the private key 1 and z = r, z * w * G = r * w * Q, so their sum must be computed by
+  // doubling.
+  const ValueType private_key = ValueType::One();
+  const auto public_key = GetPublicKey(private_key);
+  const auto upper_bound = 0x800000000000000000000000000000000000000000000000000000000000000_Z;
+  ValueType k = 0x54d7beec5ec728223671c627557efc5c9a6508425dc6c900b7741bf60afec06_Z;
+  PrimeFieldElement r = GetStarkKey(k);
+  while (r.ToStandardForm() >= upper_bound) {
+    k = k + ValueType::One();
+    r = GetStarkKey(k);
+  }
+  const Signature sig = SignEcdsa(private_key, r, k);
+  ASSERT_EQ(sig.first, r);
+
+  EXPECT_TRUE(VerifyEcdsa(public_key, r, sig));
+  EXPECT_EQ(VerifyEcdsaChecked(public_key, r, sig), VerifyStatus::kValid);
+  EXPECT_EQ(VerifyEcdsaPartialKeyChecked(public_key.x, r, sig), VerifyStatus::kValid);
+  EXPECT_EQ(
+      VerifyEcdsaChecked(public_key, r, {r, sig.second + PrimeFieldElement::One()}),
+      VerifyStatus::kInvalidSignature);
+}
+
+TEST(VerifyEcdsaParallel, CompareToVerifyEcdsaPartialKey) {
+  Prng prng;
+  using ValueType = PrimeFieldElement::ValueType;
+  const auto upper_bound = 0x800000000000000000000000000000000000000000000000000000000000000_Z;
+
+  std::vector<VerifyRequest> requests;
+  for (size_t i = 0; i < 3; ++i) {
+    const auto private_key = ValueType::RandomBigInt(&prng);
+    const auto msg =
+        PrimeFieldElement::FromBigInt(ValueType::RandomBigInt(&prng).Div(upper_bound).second);
+    requests.push_back(
+        {GetPublicKey(private_key).x, msg,
+         SignEcdsa(private_key, msg, ValueType::RandomBigInt(&prng))});
+  }
+  for (size_t i = 3; i < 20; ++i) {
+    requests.push_back(requests[i % 3]);
+  }
+  // Break some of the requests, including ones with invalid input.
+  requests[4].z = requests[4].z + PrimeFieldElement::One();
+  requests[9].sig.second = requests[9].sig.second + PrimeFieldElement::One();
+  requests[13].sig.first = PrimeFieldElement::Zero();
+  for (ValueType x = ValueType::One();; x = x + ValueType::One()) {
+    const auto public_key_x = PrimeFieldElement::FromBigInt(x);
+    if (!EcPoint<PrimeFieldElement>::GetPointFromX(
+             public_key_x, GetEcConstants().k_alpha, GetEcConstants().k_beta)
+             .has_value()) {
+      requests[18].public_key_x = public_key_x;
+      break;
+    }
+  }
+  std::vector<uint8_t> expected(requests.size(), 1);
+  for (size_t i : {4, 9, 13, 18}) {
+    expected[i] = 0;
+  }
+
+  for (size_t n_threads : {1, 3, 8}) {
+    std::vector<uint8_t> results(requests.size(), 2);
+    VerifyEcdsaParallel(requests, results, n_threads);
+    EXPECT_EQ(results, expected);
+  }
+
+  VerifyEcdsaParallel({}, {}, 4);
+  std::vector<uint8_t> results(requests.size() - 1);
+  EXPECT_ASSERT(VerifyEcdsaParallel(requests, results), HasSubstr("mismatch"));
+}
+
 TEST(VerifyEcdsa, Benchmark) {
   Prng prng;
   for (size_t i = 0; i < 100; i++) {
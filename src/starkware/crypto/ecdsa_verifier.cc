@@ -0,0 +1,147 @@
+#include "starkware/crypto/ecdsa_verifier.h"
+
+#include <algorithm>
+#include <optional>
+
+#include "starkware/crypto/elliptic_curve_constants.h"
+#include "starkware/utils/error_handling.h"
+
+namespace starkware {
+
+namespace {
+
+std::unique_ptr<EcdsaVerifier::PreparedKeyCache> MakePreparedKeyCache(size_t memory_budget) {
+  using PreparedKeyCache = EcdsaVerifier::PreparedKeyCache;
+  const size_t capacity = memory_budget / PreparedPublicKey::kMemoryUsage;
+  if (capacity == 0) {
+    return nullptr;
+  }
+  // The cache rounds its capacity up to a multiple of the number of shards, so round it down first
+  // to stay within the budget.
+  const size_t n_shards = std::min(capacity, PreparedKeyCache::kDefaultNumShards);
+  return std::make_unique<PreparedKeyCache>(capacity / n_shards * n_shards, n_shards);
+}
+
+}  // namespace
+
+size_t PrimeFieldElementHash::operator()(const PrimeFieldElement& x) const {
+  const PrimeFieldElement::ValueType value = x.ToStandardForm();
+  size_t hash = 0;
+  for (size_t i = 0; i < PrimeFieldElement::ValueType::LimbCount(); ++i) {
+    // Combines the limbs as in boost::hash_combine().
+    hash ^= std::hash<uint64_t>()(value[i]) + 0x9e3779b97f4a7c15 + (hash << 6) + (hash >> 2);
+  }
+  return hash;
+}
+
+size_t SignedMessageHash::operator()(const SignedMessage& signed_message) const {
+  const PrimeFieldElementHash element_hash;
+  size_t hash = 0;
+  for (const PrimeFieldElement* element :
+       {&signed_message.public_key_x, &signed_message.z, &signed_message.sig.first,
+        &signed_message.sig.second}) {
+    hash ^= element_hash(*element) + 0x9e3779b97f4a7c15 + (hash << 6) + (hash >> 2);
+  }
+  return hash;
+}
+
+EcdsaVerifier::EcdsaVerifier(
+    size_t public_key_cache_capacity, size_t prepared_keys_memory_budget,
+    size_t promotion_threshold, size_t verification_cache_capacity)
+    : promotion_threshold_(std::max<size_t>(promotion_threshold, 1)),
+      public_key_cache_(public_key_cache_capacity),
+      prepared_key_cache_(MakePreparedKeyCache(prepared_keys_memory_budget)),
+      verification_cache_(
+          verification_cache_capacity > 0
+              ? std::make_unique<VerificationCache>(verification_cache_capacity)
+              : nullptr) {}
+
+bool EcdsaVerifier::Verify(
+    const EcPoint<PrimeFieldElement>& public_key, const PrimeFieldElement& z,
+    const Signature& sig) const {
+  const auto& [x, y] = public_key;
+  if (y * y != x * (x * x + GetEcConstants().k_alpha) + GetEcConstants().k_beta) {
+    return false;
+  }
+  return VerifyCached(x, public_key, z, sig);
+}
+
+bool EcdsaVerifier::VerifyPartialKey(
+    const PrimeFieldElement& public_key_x, const PrimeFieldElement& z,
+    const Signature& sig) const {
+  // VerifyEcdsa() checks both the decompressed point and its negation.
+  return VerifyCached(public_key_x, std::nullopt, z, sig);
+}
+
+EcPoint<PrimeFieldElement> EcdsaVerifier::DecompressPublicKey(
+    const PrimeFieldElement& public_key_x) const {
+  return GetKnownKey(public_key_x, std::nullopt)->point;
+}
+
+std::shared_ptr<EcdsaVerifier::KnownKey> EcdsaVerifier::GetKnownKey(
+    const PrimeFieldElement& public_key_x,
+    const std::optional<EcPoint<PrimeFieldElement>>& public_key) const {
+  const std::optional<std::shared_ptr<KnownKey>> cached = public_key_cache_.Get(public_key_x);
+  if (cached.has_value()) {
+    return *cached;
+  }
+
+  std::optional<EcPoint<PrimeFieldElement>> point = public_key;
+  if (!point.has_value()) {
+    point = EcPoint<PrimeFieldElement>::GetPointFromX(
+        public_key_x, GetEcConstants().k_alpha, GetEcConstants().k_beta);
+    ASSERT(
+        point.has_value(), "Given public key (" + public_key_x.ToString() +
+                               ") does not correspond to a valid point on the elliptic curve.");
+  }
+  auto known_key = std::make_shared<KnownKey>(*point);
+  public_key_cache_.Insert(public_key_x, known_key);
+  return known_key;
+}
+
+bool EcdsaVerifier::VerifyCached(
+    const PrimeFieldElement& public_key_x,
+    const std::optional<EcPoint<PrimeFieldElement>>& public_key, const PrimeFieldElement& z,
+    const Signature& sig) const {
+  if (verification_cache_ == nullptr) {
+    return VerifyKnownKey(public_key_x, public_key, z, sig);
+  }
+  // Q and -Q are both accepted, so the signature is identified by the x coordinate of the key. This
+  // relies on Verify() rejecting the points that are not on the curve, since their results would be
+  // returned for any key with the same x coordinate.
+  const SignedMessage signed_message{public_key_x, z, sig};
+  if (verification_cache_->Get(signed_message).has_value()) {
+    return true;
+  }
+  const bool is_valid = VerifyKnownKey(public_key_x, public_key, z, sig);
+  if (is_valid) {
+    verification_cache_->Insert(signed_message, true);
+  }
+  return is_valid;
+}
+
+bool EcdsaVerifier::VerifyKnownKey(
+    const PrimeFieldElement& public_key_x,
+    const std::optional<EcPoint<PrimeFieldElement>>& public_key, const PrimeFieldElement& z,
+    const Signature& sig) const {
+  if (prepared_key_cache_ != nullptr) {
+    const auto prepared_key = prepared_key_cache_->Get(public_key_x);
+    if (prepared_key.has_value()) {
+      // Q and -Q have the same x coordinate, and VerifyEcdsa() accepts both.
+      return VerifyEcdsa(**prepared_key, z, sig);
+    }
+  }
+
+  const std::shared_ptr<KnownKey> known_key = GetKnownKey(public_key_x, public_key);
+  // Exactly one of the threads that use the key concurrently reaches the threshold.
+  if (prepared_key_cache_ != nullptr &&
+      (known_key->n_uses.fetch_add(1, std::memory_order_relaxed) + 1) % promotion_threshold_ ==
+          0) {
+    auto prepared_key = std::make_shared<const PreparedPublicKey>(known_key->point);
+    prepared_key_cache_->Insert(public_key_x, prepared_key);
+    return VerifyEcdsa(*prepared_key, z, sig);
+  }
+  return VerifyEcdsa(known_key->point, z, sig);
+}
+
+}  // namespace starkware
@@ -0,0 +1,162 @@
+#ifndef STARKWARE_CRYPTO_ECDSA_VERIFIER_H_
+#define STARKWARE_CRYPTO_ECDSA_VERIFIER_H_
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <optional>
+
+#include "starkware/algebra/elliptic_curve.h"
+#include "starkware/algebra/prime_field_element.h"
+#include "starkware/crypto/ecdsa.h"
+#include "starkware/crypto/fixed_base_table.h"
+#include "starkware/utils/concurrent_lru_cache.h"
+
+namespace starkware {
+
+/*
+  Hashes a field element by its standard representation.
+*/
+struct PrimeFieldElementHash {
+  size_t operator()(const PrimeFieldElement& x) const;
+};
+
+/*
+  A signature sig of the message hash z with the public key whose x coordinate is public_key_x.
+*/
+struct SignedMessage {
+  bool operator==(const SignedMessage& other) const {
+    return public_key_x == other.public_key_x && z == other.z && sig == other.sig;
+  }
+
+  PrimeFieldElement public_key_x;
+  PrimeFieldElement z;
+  Signature sig;
+};
+
+struct SignedMessageHash {
+  size_t operator()(const SignedMessage& signed_message) const;
+};
+
+/*
+  A context for verifying many signatures, which keeps state between verifications.
+
+  Decompressing a public key (computing its y coordinate from its x coordinate) requires a square
+  root, which costs about as much as a scalar multiplication. Since most traffic comes from a small
+  set of active keys, the verifier keeps the decompressed keys in a bounded cache.
+
+  Optionally, the verifier also remembers signatures that were found valid, so that replays of the
+  same signed message (e.g., retries) are accepted without verifying them again. Only valid
+  signatures are kept, in a cache of verification_cache_capacity entries (0 disables it). The
+  entries are compared in full, so a hash collision cannot cause a false acceptance.
+
+  In addition, keys that sign often may be promoted to a PreparedPublicKey, whose signatures are
+  verified with two fixed-base multiplications. A key is promoted every promotion_threshold uses
+  while it is not prepared, and the prepared keys are kept in an LRU cache whose size is bounded
+  by prepared_keys_memory_budget bytes (0 disables the promotion).
+
+  An EcdsaVerifier may be shared by multiple threads. The free functions in ecdsa.h remain available
+  for callers that do not need a cache.
+*/
+class EcdsaVerifier {
+ public:
+  /*
+    A public key that was used recently, with the number of times it was used while it was not
+    prepared.
+  */
+  struct KnownKey {
+    explicit KnownKey(const EcPoint<PrimeFieldElement>& point) : point(point) {}
+
+    const EcPoint<PrimeFieldElement> point;
+    std::atomic<size_t> n_uses{0};
+  };
+
+  using PublicKeyCache =
+      ConcurrentLruCache<PrimeFieldElement, std::shared_ptr<KnownKey>, PrimeFieldElementHash>;
+  using PreparedKeyCache = ConcurrentLruCache<
+      PrimeFieldElement, std::shared_ptr<const PreparedPublicKey>, PrimeFieldElementHash>;
+  // The value is unused, since only valid signatures are kept.
+  using VerificationCache = ConcurrentLruCache<SignedMessage, bool, SignedMessageHash>;
+
+  static constexpr size_t kDefaultPublicKeyCacheCapacity = 4096;
+  static constexpr size_t kDefaultPromotionThreshold = 8;
+
+  explicit EcdsaVerifier(
+      size_t public_key_cache_capacity = kDefaultPublicKeyCacheCapacity,
+      size_t prepared_keys_memory_budget = 0,
+      size_t promotion_threshold = kDefaultPromotionThreshold,
+      size_t verification_cache_capacity = 0);
+
+  /*
+    Same as VerifyEcdsa(), but uses the caches of public_key.x. Returns false if public_key is not
+    on the curve, since such a point must not replace the key decompressed from its x coordinate.
+  */
+  bool Verify(
+      const EcPoint<PrimeFieldElement>& public_key, const PrimeFieldElement& z,
+      const Signature& sig) const;
+
+  /*
+    Same as VerifyEcdsaPartialKey(), but uses the caches of decompressed and prepared public keys.
+  */
+  bool VerifyPartialKey(
+      const PrimeFieldElement& public_key_x, const PrimeFieldElement& z,
+      const Signature& sig) const;
+
+  /*
+    Returns one of the two points whose x coordinate is public_key_x, using the cache. Throws if
+    there is no such point.
+  */
+  EcPoint<PrimeFieldElement> DecompressPublicKey(const PrimeFieldElement& public_key_x) const;
+
+  const PublicKeyCache& GetPublicKeyCache() const { return public_key_cache_; }
+
+  /*
+    Returns the cache of prepared keys, or nullptr if promotion is disabled.
+  */
+  const PreparedKeyCache* GetPreparedKeyCache() const { return prepared_key_cache_.get(); }
+
+  /*
+    Returns the cache of valid signatures, or nullptr if it is disabled. Its Hits() and Misses()
+    count the signatures that were, or were not, found in it.
+  */
+  const VerificationCache* GetVerificationCache() const { return verification_cache_.get(); }
+
+ private:
+  /*
+    Returns the entry of public_key_x in the public key cache, adding it if needed. public_key is
+    the point, if it is known and on the curve, and otherwise it is decompressed from public_key_x.
+  */
+  std::shared_ptr<KnownKey> GetKnownKey(
+      const PrimeFieldElement& public_key_x,
+      const std::optional<EcPoint<PrimeFieldElement>>& public_key) const;
+
+  /*
+    Verifies a signature of the key whose x coordinate is public_key_x, using the cache of valid
+    signatures if it is enabled. Since the results are shared by Q and -Q, public_key must be on the
+    curve, if it is given.
+  */
+  bool VerifyCached(
+      const PrimeFieldElement& public_key_x,
+      const std::optional<EcPoint<PrimeFieldElement>>& public_key, const PrimeFieldElement& z,
+      const Signature& sig) const;
+
+  /*
+    Verifies a signature of the key whose x coordinate is public_key_x, using its prepared key if
+    there is one, and promoting it if it has reached the threshold.
+  */
+  bool VerifyKnownKey(
+      const PrimeFieldElement& public_key_x,
+      const std::optional<EcPoint<PrimeFieldElement>>& public_key, const PrimeFieldElement& z,
+      const Signature& sig) const;
+
+  const size_t promotion_threshold_;
+  mutable PublicKeyCache public_key_cache_;
+  // nullptr if promotion is disabled.
+  const std::unique_ptr<PreparedKeyCache> prepared_key_cache_;
+  // nullptr if the cache of valid signatures is disabled.
+  const std::unique_ptr<VerificationCache> verification_cache_;
+};
+
+}  // namespace starkware
+
+#endif  // STARKWARE_CRYPTO_ECDSA_VERIFIER_H_
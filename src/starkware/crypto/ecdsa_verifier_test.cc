@@ -0,0 +1,154 @@
+#include "starkware/crypto/ecdsa_verifier.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "starkware/crypto/elliptic_curve_constants.h"
+#include "starkware/utils/test_utils.h"
+
+namespace starkware {
+namespace {
+
+using testing::HasSubstr;
+
+TEST(EcdsaVerifier, VerifyPartialKey) {
+  // The values of the VerifyEcdsa.Regression test in ecdsa_test.cc.
+  const auto public_key_x = PrimeFieldElement::FromBigInt(
+      0x77a3b314db07c45076d11f62b6f9e748a39790441823307743cf00d6597ea43_Z);
+  const auto public_key_y = PrimeFieldElement::FromBigInt(
+      0x54d7beec5ec728223671c627557efc5c9a6508425dc6c900b7741bf60afec06_Z);
+  const auto z = PrimeFieldElement::FromBigInt(
+      0x397e76d1667c4454bfb83514e120583af836f8e32a516765497823eabe16a3f_Z);
+  const auto r = PrimeFieldElement::FromBigInt(
+      0x173fd03d8b008ee7432977ac27d1e9d1a1f6c98b1a2f05fa84a21c84c44e882_Z);
+  const auto w = PrimeFieldElement::FromBigInt(
+      0x1f2c44a7798f55192f153b4c48ea5c1241fbb69e6132cc8a0da9c5b62a4286e_Z);
+
+  const EcdsaVerifier verifier;
+  EXPECT_TRUE(verifier.VerifyPartialKey(public_key_x, z, {r, w}));
+  EXPECT_EQ(verifier.GetPublicKeyCache().Misses(), 1U);
+  EXPECT_TRUE(verifier.VerifyPartialKey(public_key_x, z, {r, w}));
+  EXPECT_FALSE(verifier.VerifyPartialKey(public_key_x, z + PrimeFieldElement::One(), {r, w}));
+  EXPECT_EQ(verifier.GetPublicKeyCache().Hits(), 2U);
+  EXPECT_EQ(verifier.GetPublicKeyCache().Misses(), 1U);
+
+  const EcPoint<PrimeFieldElement> point = verifier.DecompressPublicKey(public_key_x);
+  EXPECT_EQ(point.x, public_key_x);
+  EXPECT_TRUE(point.y == public_key_y || point.y == -public_key_y);
+
+  // Keys that are not the x coordinate of a point are rejected, and not cached.
+  PrimeFieldElement invalid_x = PrimeFieldElement::One();
+  while (EcPoint<PrimeFieldElement>::GetPointFromX(
+             invalid_x, GetEcConstants().k_alpha, GetEcConstants().k_beta)
+             .has_value()) {
+    invalid_x = invalid_x + PrimeFieldElement::One();
+  }
+  EXPECT_ASSERT(verifier.VerifyPartialKey(invalid_x, z, {r, w}), HasSubstr("does not correspond"));
+  EXPECT_EQ(verifier.GetPublicKeyCache().Size(), 1U);
+}
+
+TEST(EcdsaVerifier, CacheIsBounded) {
+  Prng prng;
+  const EcdsaVerifier verifier(20);
+  for (size_t i = 0; i < 100; ++i) {
+    const auto point = EcPoint<PrimeFieldElement>::Random(
+        GetEcConstants().k_alpha, GetEcConstants().k_beta, &prng);
+    EXPECT_EQ(verifier.DecompressPublicKey(point.x).x, point.x);
+  }
+  EXPECT_LE(verifier.GetPublicKeyCache().Size(), 32U);
+}
+
+TEST(EcdsaVerifier, PromotesHotKeys) {
+  Prng prng;
+  using ValueType = PrimeFieldElement::ValueType;
+  const auto private_key = ValueType::RandomBigInt(&prng);
+  const auto public_key = GetPublicKey(private_key);
+  const auto z = PrimeFieldElement::FromUint(prng.RandomUint64());
+  const Signature sig = SignEcdsa(private_key, z, ValueType::RandomBigInt(&prng));
+
+  EXPECT_EQ(EcdsaVerifier().GetPreparedKeyCache(), nullptr);
+  EXPECT_EQ(EcdsaVerifier(1, PreparedPublicKey::kMemoryUsage - 1).GetPreparedKeyCache(), nullptr);
+
+  const EcdsaVerifier verifier(16, 2 * PreparedPublicKey::kMemoryUsage, 3);
+  const EcdsaVerifier::PreparedKeyCache* prepared_keys = verifier.GetPreparedKeyCache();
+  ASSERT_NE(prepared_keys, nullptr);
+  for (size_t i = 0; i < 2; ++i) {
+    EXPECT_TRUE(verifier.Verify(public_key, z, sig));
+    EXPECT_TRUE(verifier.VerifyPartialKey(public_key.x, z, sig));
+    EXPECT_EQ(prepared_keys->Size(), i);
+  }
+  // The key was promoted on its third use, and since then its prepared key is used.
+  EXPECT_EQ(prepared_keys->Hits(), 1U);
+  EXPECT_TRUE(verifier.Verify(-public_key, z, sig));
+  EXPECT_FALSE(verifier.VerifyPartialKey(public_key.x, z + PrimeFieldElement::One(), sig));
+  EXPECT_EQ(prepared_keys->Hits(), 3U);
+  EXPECT_EQ(prepared_keys->Size(), 1U);
+}
+
+TEST(EcdsaVerifier, RejectsPointsNotOnCurve) {
+  Prng prng;
+  using ValueType = PrimeFieldElement::ValueType;
+  const auto private_key = ValueType::RandomBigInt(&prng);
+  const auto public_key = GetPublicKey(private_key);
+  const auto z = PrimeFieldElement::FromUint(prng.RandomUint64());
+  const Signature sig = SignEcdsa(private_key, z, ValueType::RandomBigInt(&prng));
+  const EcPoint<PrimeFieldElement> bad_point(public_key.x, public_key.y + PrimeFieldElement::One());
+
+  const EcdsaVerifier verifier(16, 2 * PreparedPublicKey::kMemoryUsage, 1);
+  EXPECT_FALSE(verifier.Verify(bad_point, z, sig));
+  EXPECT_EQ(verifier.GetPublicKeyCache().Size(), 0U);
+  EXPECT_EQ(verifier.GetPreparedKeyCache()->Size(), 0U);
+
+  // The key of public_key.x is still decompressed from it, and not taken from bad_point.
+  EXPECT_TRUE(verifier.VerifyPartialKey(public_key.x, z, sig));
+  const EcPoint<PrimeFieldElement> point = verifier.DecompressPublicKey(public_key.x);
+  EXPECT_TRUE(point == public_key || point == -public_key);
+  EXPECT_FALSE(verifier.Verify(bad_point, z, sig));
+}
+
+TEST(EcdsaVerifier, VerificationCache) {
+  Prng prng;
+  using ValueType = PrimeFieldElement::ValueType;
+  const auto private_key = ValueType::RandomBigInt(&prng);
+  const auto public_key = GetPublicKey(private_key);
+  const auto z = PrimeFieldElement::FromUint(prng.RandomUint64());
+  const Signature sig = SignEcdsa(private_key, z, ValueType::RandomBigInt(&prng));
+  const Signature bad_sig = {sig.first, sig.second + PrimeFieldElement::One()};
+
+  EXPECT_EQ(EcdsaVerifier().GetVerificationCache(), nullptr);
+  const EcdsaVerifier verifier(16, 0, EcdsaVerifier::kDefaultPromotionThreshold, 16);
+  const EcdsaVerifier::VerificationCache* verification_cache = verifier.GetVerificationCache();
+  ASSERT_NE(verification_cache, nullptr);
+
+  EXPECT_TRUE(verifier.VerifyPartialKey(public_key.x, z, sig));
+  EXPECT_EQ(verification_cache->Misses(), 1U);
+  // Replays are found in the cache, for both the partial and the full public key.
+  EXPECT_TRUE(verifier.VerifyPartialKey(public_key.x, z, sig));
+  EXPECT_TRUE(verifier.Verify(-public_key, z, sig));
+  EXPECT_EQ(verification_cache->Hits(), 2U);
+  // Invalid signatures are not kept.
+  for (size_t i = 0; i < 2; ++i) {
+    EXPECT_FALSE(verifier.VerifyPartialKey(public_key.x, z, bad_sig));
+    EXPECT_FALSE(verifier.VerifyPartialKey(public_key.x, z + PrimeFieldElement::One(), sig));
+  }
+  EXPECT_EQ(verification_cache->Size(), 1U);
+  EXPECT_EQ(verification_cache->Hits(), 2U);
+  EXPECT_EQ(verification_cache->Misses(), 5U);
+  // Only the public key cache was used for the other verifications.
+  EXPECT_EQ(verifier.GetPublicKeyCache().Hits(), 4U);
+
+  // Results for points that are not on the curve are not kept, so they are not returned for their
+  // x coordinate.
+  const EcPoint<PrimeFieldElement> bad_point(public_key.x, public_key.y + PrimeFieldElement::One());
+  const auto other_z = z + PrimeFieldElement::One();
+  const Signature other_sig = SignEcdsa(private_key, other_z, ValueType::RandomBigInt(&prng));
+  EXPECT_FALSE(verifier.Verify(bad_point, other_z, other_sig));
+  EXPECT_FALSE(verifier.Verify(bad_point, z, sig));
+  EXPECT_EQ(verification_cache->Size(), 1U);
+  EXPECT_TRUE(verifier.VerifyPartialKey(public_key.x, other_z, other_sig));
+  EXPECT_FALSE(verifier.VerifyPartialKey(public_key.x, other_z, bad_sig));
+  EXPECT_EQ(verification_cache->Size(), 2U);
+}
+
+}  // namespace
+}  // namespace starkware
@@ -0,0 +1,86 @@
+#include "starkware/crypto/ffi/arithmetic.h"
+
+#include <optional>
+
+#include "third_party/gsl/gsl-lite.hpp"
+
+#include "starkware/algebra/elliptic_curve.h"
+#include "starkware/algebra/prime_field_element.h"
+#include "starkware/crypto/elliptic_curve_constants.h"
+#include "starkware/crypto/ffi/utils.h"
+#include "starkware/crypto/fixed_base_table.h"
+#include "starkware/utils/error_handling.h"
+
+namespace starkware {
+
+namespace {
+
+using ValueType = PrimeFieldElement::ValueType;
+using EcPointT = EcPoint<PrimeFieldElement>;
+
+constexpr size_t kElementSize = sizeof(ValueType);
+constexpr size_t kPointSize = 2 * kElementSize;
+
+}  // namespace
+
+extern "C" int EcAdd(
+    const gsl::byte p[kPointSize], const gsl::byte q[kPointSize], gsl::byte out[kPointSize]) {
+  return CallWithErrorCode([&] {
+    const std::optional<EcPointT> p_point = DeserializePoint(gsl::make_span(p, kPointSize));
+    const std::optional<EcPointT> q_point = DeserializePoint(gsl::make_span(q, kPointSize));
+    SerializePoint(
+        p_point ? p_point->AddOptionalPoint(q_point, GetEcConstants().k_alpha) : q_point,
+        gsl::make_span(out, kPointSize));
+  });
+}
+
+extern "C" int EcMul(
+    const gsl::byte p[kPointSize], const gsl::byte scalar[kElementSize],
+    gsl::byte out[kPointSize]) {
+  return CallWithErrorCode([&] {
+    const std::optional<EcPointT> point = DeserializePoint(gsl::make_span(p, kPointSize));
+    const ValueType value = Deserialize(gsl::make_span(scalar, kElementSize));
+    SerializePoint(
+        point ? EcPointT::MultiScalarMultiply(
+                    gsl::make_span(&*point, 1), gsl::make_span(&value, 1), GetEcConstants().k_alpha)
+              : std::nullopt,
+        gsl::make_span(out, kPointSize));
+  });
+}
+
+extern "C" int EcMulGenerator(const gsl::byte scalar[kElementSize], gsl::byte out[kPointSize]) {
+  return CallWithErrorCode([&] {
+    const auto point =
+        GetGeneratorTable().Multiply(Deserialize(gsl::make_span(scalar, kElementSize)));
+    SerializePoint(
+        point ? std::optional<EcPointT>(
+                    EcPointT(point->x.ToBaseFieldElement(), point->y.ToBaseFieldElement()))
+              : std::nullopt,
+        gsl::make_span(out, kPointSize));
+  });
+}
+
+extern "C" int FieldMul(
+    const gsl::byte a[kElementSize], const gsl::byte b[kElementSize],
+    gsl::byte out[kElementSize]) {
+  return CallWithErrorCode([&] {
+    const PrimeFieldElement product = DeserializeFieldElement(gsl::make_span(a, kElementSize)) *
+                                      DeserializeFieldElement(gsl::make_span(b, kElementSize));
+    Serialize(product.ToStandardForm(), gsl::make_span(out, kElementSize));
+  });
+}
+
+extern "C" int FieldInv(const gsl::byte a[kElementSize], gsl::byte out[kElementSize]) {
+  return CallWithErrorCode([&] {
+    const ValueType value = Deserialize(gsl::make_span(a, kElementSize));
+    ASSERT(
+        value != ValueType::Zero() && value < PrimeFieldElement::kModulus,
+        "Field element must be in the range [1, prime).");
+    // The inversion is done in standard form, which is faster than PrimeFieldElement::Inverse().
+    Serialize(
+        value.InvModPrimeVariableTime(PrimeFieldElement::kModulus),
+        gsl::make_span(out, kElementSize));
+  });
+}
+
+}  // namespace starkware
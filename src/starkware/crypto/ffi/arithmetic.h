@@ -0,0 +1,42 @@
+#ifndef STARKWARE_CRYPTO_FFI_ARITHMETIC_H_
+#define STARKWARE_CRYPTO_FFI_ARITHMETIC_H_
+
+#include "error.h"
+
+/*
+  Arithmetic of the STARK curve and of its field of definition.
+
+  Field elements and scalars are of 32 bytes in little-endian. Field elements must be smaller than
+  the field's prime; scalars may be any 256-bit value. Points are of 64 bytes: the x coordinate
+  followed by the y coordinate. The curve's zero element is encoded as (0, 0), and every other
+  point must be on the curve.
+  The functions return a CryptoError (see error.h).
+*/
+
+/*
+  out = p + q.
+*/
+int EcAdd(const char* p, const char* q, char* out);
+
+/*
+  out = scalar * p.
+*/
+int EcMul(const char* p, const char* scalar, char* out);
+
+/*
+  out = scalar * G, where G is the generator of the curve. Several times faster than EcMul(), as it
+  uses a precomputed table of G.
+*/
+int EcMulGenerator(const char* scalar, char* out);
+
+/*
+  out = a * b.
+*/
+int FieldMul(const char* a, const char* b, char* out);
+
+/*
+  out = a^-1. a must not be zero. The running time depends on a, so a should not be secret.
+*/
+int FieldInv(const char* a, char* out);
+
+#endif  // STARKWARE_CRYPTO_FFI_ARITHMETIC_H_
@@ -0,0 +1,492 @@
+#include "starkware/crypto/ffi/batch.h"
+
+#include <algorithm>
+#include <optional>
+#include <vector>
+
+#include "third_party/gsl/gsl-lite.hpp"
+
+#include "starkware/algebra/elliptic_curve.h"
+#include "starkware/algebra/field_operations.h"
+#include "starkware/algebra/fraction_field_element.h"
+#include "starkware/algebra/prime_field_element.h"
+#include "starkware/crypto/ecdsa.h"
+#include "starkware/crypto/elliptic_curve_constants.h"
+#include "starkware/crypto/ffi/utils.h"
+#include "starkware/crypto/fixed_base_table.h"
+#include "starkware/crypto/pedersen_hash.h"
+#include "starkware/utils/error_handling.h"
+#include "starkware/utils/parallel.h"
+
+namespace starkware {
+
+namespace {
+
+using ValueType = PrimeFieldElement::ValueType;
+using EcPointT = EcPoint<PrimeFieldElement>;
+
+constexpr size_t kElementSize = sizeof(ValueType);
+constexpr size_t kPointSize = 2 * kElementSize;
+
+// The minimal number of items per thread, so that the batched computations of each thread (e.g.,
+// the shared inversions) are amortized over enough items.
+constexpr size_t kMinHashesPerThread = 256;
+constexpr size_t kMinSignaturesPerThread = 16;
+constexpr size_t kMinKeysPerThread = 64;
+constexpr size_t kMinVerificationsPerThread = 4;
+constexpr size_t kMinEcAdditionsPerThread = 256;
+constexpr size_t kMinEcMultiplicationsPerThread = 4;
+constexpr size_t kMinFieldMultiplicationsPerThread = 4096;
+constexpr size_t kMinFieldInversionsPerThread = 256;
+constexpr size_t kMinConversionsPerThread = 4096;
+
+ValueType ReadValue(const gsl::byte* array, size_t index) {
+  return Deserialize(gsl::make_span(array + index * kElementSize, kElementSize));
+}
+
+PrimeFieldElement ReadElement(const gsl::byte* array, size_t index) {
+  return PrimeFieldElement::FromBigInt(ReadValue(array, index));
+}
+
+void WriteElement(const PrimeFieldElement& element, gsl::byte* array, size_t index) {
+  Serialize(element.ToStandardForm(), gsl::make_span(array + index * kElementSize, kElementSize));
+}
+
+void ZeroElement(gsl::byte* array, size_t index) {
+  std::fill_n(array + index * kElementSize, kElementSize, gsl::byte{0});
+}
+
+/*
+  Returns the ElementFormat of the given value of a format argument.
+*/
+ElementFormat ToElementFormat(int format) {
+  ASSERT(
+      format == ELEMENT_FORMAT_STANDARD || format == ELEMENT_FORMAT_MONTGOMERY,
+      "Unknown element format.");
+  return static_cast<ElementFormat>(format);
+}
+
+/*
+  Reads the elements [begin, end) of array, in the given format.
+*/
+std::vector<PrimeFieldElement> ReadElements(
+    const gsl::byte* array, size_t begin, size_t end, ElementFormat format) {
+  std::vector<PrimeFieldElement> elements(end - begin, PrimeFieldElement::Zero());
+  DeserializeFieldElements(
+      gsl::make_span(array + begin * kElementSize, (end - begin) * kElementSize), format,
+      elements);
+  return elements;
+}
+
+/*
+  Writes elements to array, starting at index begin, in the given format.
+*/
+void WriteElements(
+    gsl::span<const PrimeFieldElement> elements, ElementFormat format, gsl::byte* array,
+    size_t begin) {
+  SerializeFieldElements(
+      elements, format,
+      gsl::make_span(array + begin * kElementSize, elements.size() * kElementSize));
+}
+
+std::optional<EcPointT> ReadPoint(const gsl::byte* array, size_t index) {
+  return DeserializePoint(gsl::make_span(array + index * kPointSize, kPointSize));
+}
+
+void WritePoint(const std::optional<EcPointT>& point, gsl::byte* array, size_t index) {
+  SerializePoint(point, gsl::make_span(array + index * kPointSize, kPointSize));
+}
+
+BatchStatus ToBatchStatus(VerifyStatus status) {
+  switch (status) {
+    case VerifyStatus::kValid:
+      return BATCH_STATUS_OK;
+    case VerifyStatus::kInvalidSignature:
+      return BATCH_STATUS_INVALID_SIGNATURE;
+    default:
+      return BATCH_STATUS_INVALID_INPUT;
+  }
+}
+
+/*
+  Calls item_func(i) for every item in [begin, end), and sets the status of every item it throws on
+  to BATCH_STATUS_INVALID_INPUT, and that of every other item to BATCH_STATUS_OK.
+*/
+template <typename ItemFunc>
+void ProcessItems(size_t begin, size_t end, const ItemFunc& item_func, gsl::byte* statuses) {
+  for (size_t i = begin; i < end; ++i) {
+    try {
+      statuses[i] = gsl::byte{BATCH_STATUS_OK};
+      item_func(i);
+    } catch (const StarkwareException&) {
+      statuses[i] = gsl::byte{BATCH_STATUS_INVALID_INPUT};
+    }
+  }
+}
+
+/*
+  Calls batch_func(begin, end), which processes the items [begin, end) together. If it throws
+  (i.e., some item is invalid), processes the items one by one with item_func(i) instead, and sets
+  the status of every item item_func() throws on to BATCH_STATUS_INVALID_INPUT.
+*/
+template <typename BatchFunc, typename ItemFunc>
+void ProcessChunk(
+    size_t begin, size_t end, const BatchFunc& batch_func, const ItemFunc& item_func,
+    gsl::byte* statuses) {
+  std::fill(statuses + begin, statuses + end, gsl::byte{BATCH_STATUS_OK});
+  try {
+    batch_func(begin, end);
+    return;
+  } catch (const StarkwareException&) {
+  }
+  ProcessItems(begin, end, item_func, statuses);
+}
+
+}  // namespace
+
+extern "C" int ConvertElements(
+    const gsl::byte* elements, size_t n, size_t n_threads, int from_format, int to_format,
+    gsl::byte* out, gsl::byte* statuses) {
+  try {
+    const ElementFormat from = ToElementFormat(from_format);
+    const ElementFormat to = ToElementFormat(to_format);
+    ParallelFor(
+        n, n_threads,
+        [&](size_t begin, size_t end) {
+          ProcessChunk(
+              begin, end,
+              [&](size_t begin, size_t end) {
+                WriteElements(ReadElements(elements, begin, end, from), to, out, begin);
+              },
+              [&](size_t i) {
+                ZeroElement(out, i);
+                WriteElements(ReadElements(elements, i, i + 1, from), to, out, i);
+              },
+              statuses);
+        },
+        kMinConversionsPerThread);
+  } catch (...) {
+    return 1;
+  }
+  return 0;
+}
+
+extern "C" int HashBatchWithFormat(
+    const gsl::byte* xs, const gsl::byte* ys, size_t n, size_t n_threads, int format,
+    gsl::byte* out, gsl::byte* statuses) {
+  try {
+    const ElementFormat element_format = ToElementFormat(format);
+    ParallelFor(
+        n, n_threads,
+        [&](size_t begin, size_t end) {
+          ProcessChunk(
+              begin, end,
+              [&](size_t begin, size_t end) {
+                const auto chunk_xs = ReadElements(xs, begin, end, element_format);
+                const auto chunk_ys = ReadElements(ys, begin, end, element_format);
+                std::vector<PrimeFieldElement> hashes(end - begin, PrimeFieldElement::Zero());
+                PedersenHashBatch(chunk_xs, chunk_ys, hashes);
+                WriteElements(hashes, element_format, out, begin);
+              },
+              [&](size_t i) {
+                ZeroElement(out, i);
+                const PrimeFieldElement hash = PedersenHash(
+                    ReadElements(xs, i, i + 1, element_format)[0],
+                    ReadElements(ys, i, i + 1, element_format)[0]);
+                WriteElements(gsl::make_span(&hash, 1), element_format, out, i);
+              },
+              statuses);
+        },
+        kMinHashesPerThread);
+  } catch (...) {
+    return 1;
+  }
+  return 0;
+}
+
+extern "C" int HashBatch(
+    const gsl::byte* xs, const gsl::byte* ys, size_t n, size_t n_threads, gsl::byte* out,
+    gsl::byte* statuses) {
+  return HashBatchWithFormat(xs, ys, n, n_threads, ELEMENT_FORMAT_STANDARD, out, statuses);
+}
+
+extern "C" int VerifyBatch(
+    const gsl::byte* stark_keys, const gsl::byte* msg_hashes, const gsl::byte* signatures,
+    size_t n, size_t n_threads, gsl::byte* statuses) {
+  try {
+    ParallelFor(
+        n, n_threads,
+        [&](size_t begin, size_t end) {
+          for (size_t i = begin; i < end; ++i) {
+            const ValueType stark_key = ReadValue(stark_keys, i);
+            const ValueType msg_hash = ReadValue(msg_hashes, i);
+            const ValueType r = ReadValue(signatures, 2 * i);
+            const ValueType w = ReadValue(signatures, 2 * i + 1);
+            // Values that are not field elements are rejected before the conversion, which would
+            // throw.
+            const auto& prime = PrimeFieldElement::kModulus;
+            if (stark_key >= prime || msg_hash >= prime || r >= prime || w >= prime) {
+              statuses[i] = gsl::byte{BATCH_STATUS_INVALID_INPUT};
+              continue;
+            }
+            const VerifyStatus status = VerifyEcdsaPartialKeyChecked(
+                PrimeFieldElement::FromBigInt(stark_key), PrimeFieldElement::FromBigInt(msg_hash),
+                {PrimeFieldElement::FromBigInt(r), PrimeFieldElement::FromBigInt(w)});
+            statuses[i] = gsl::byte{static_cast<unsigned char>(ToBatchStatus(status))};
+          }
+        },
+        kMinVerificationsPerThread);
+  } catch (...) {
+    return 1;
+  }
+  return 0;
+}
+
+extern "C" int SignBatch(
+    const gsl::byte* private_keys, const gsl::byte* messages, const gsl::byte* ks, size_t n,
+    size_t n_threads, gsl::byte* out, gsl::byte* statuses) {
+  try {
+    const auto write_signature = [out](const Signature& sig, size_t i) {
+      WriteElement(sig.first, out, 2 * i);
+      WriteElement(sig.second, out, 2 * i + 1);
+    };
+    ParallelFor(
+        n, n_threads,
+        [&](size_t begin, size_t end) {
+          ProcessChunk(
+              begin, end,
+              [&](size_t begin, size_t end) {
+                std::vector<ValueType> chunk_keys, chunk_ks;
+                std::vector<PrimeFieldElement> chunk_msgs;
+                chunk_keys.reserve(end - begin);
+                chunk_msgs.reserve(end - begin);
+                chunk_ks.reserve(end - begin);
+                for (size_t i = begin; i < end; ++i) {
+                  chunk_keys.push_back(ReadValue(private_keys, i));
+                  chunk_msgs.push_back(ReadElement(messages, i));
+                  chunk_ks.push_back(ReadValue(ks, i));
+                }
+                const std::vector<Signature> sigs =
+                    SignEcdsaBatch(chunk_keys, chunk_msgs, chunk_ks);
+                for (size_t i = begin; i < end; ++i) {
+                  write_signature(sigs[i - begin], i);
+                }
+              },
+              [&](size_t i) {
+                ZeroElement(out, 2 * i);
+                ZeroElement(out, 2 * i + 1);
+                write_signature(
+                    SignEcdsa(
+                        ReadValue(private_keys, i), ReadElement(messages, i), ReadValue(ks, i)),
+                    i);
+              },
+              statuses);
+        },
+        kMinSignaturesPerThread);
+  } catch (...) {
+    return 1;
+  }
+  return 0;
+}
+
+extern "C" int GetPublicKeyBatch(
+    const gsl::byte* private_keys, size_t n, size_t n_threads, gsl::byte* out,
+    gsl::byte* statuses) {
+  try {
+    ParallelFor(
+        n, n_threads,
+        [&](size_t begin, size_t end) {
+          ProcessChunk(
+              begin, end,
+              [&](size_t begin, size_t end) {
+                std::vector<ValueType> chunk_keys;
+                chunk_keys.reserve(end - begin);
+                for (size_t i = begin; i < end; ++i) {
+                  chunk_keys.push_back(ReadValue(private_keys, i));
+                }
+                // The chunk is already handled by a single thread.
+                const auto public_keys = GetPublicKeysBatch(chunk_keys, 1);
+                for (size_t i = begin; i < end; ++i) {
+                  WriteElement(public_keys[i - begin].x, out, i);
+                }
+              },
+              [&](size_t i) {
+                ZeroElement(out, i);
+                WriteElement(GetStarkKey(ReadValue(private_keys, i)), out, i);
+              },
+              statuses);
+        },
+        kMinKeysPerThread);
+  } catch (...) {
+    return 1;
+  }
+  return 0;
+}
+
+extern "C" int EcAddBatch(
+    const gsl::byte* ps, const gsl::byte* qs, size_t n, size_t n_threads, gsl::byte* out,
+    gsl::byte* statuses) {
+  try {
+    ParallelFor(
+        n, n_threads,
+        [&](size_t begin, size_t end) {
+          ProcessItems(
+              begin, end,
+              [&](size_t i) {
+                WritePoint(std::nullopt, out, i);
+                const std::optional<EcPointT> p = ReadPoint(ps, i);
+                const std::optional<EcPointT> q = ReadPoint(qs, i);
+                WritePoint(p ? p->AddOptionalPoint(q, GetEcConstants().k_alpha) : q, out, i);
+              },
+              statuses);
+        },
+        kMinEcAdditionsPerThread);
+  } catch (...) {
+    return 1;
+  }
+  return 0;
+}
+
+extern "C" int EcMulBatch(
+    const gsl::byte* points, const gsl::byte* scalars, size_t n, size_t n_threads, gsl::byte* out,
+    gsl::byte* statuses) {
+  try {
+    ParallelFor(
+        n, n_threads,
+        [&](size_t begin, size_t end) {
+          ProcessItems(
+              begin, end,
+              [&](size_t i) {
+                WritePoint(std::nullopt, out, i);
+                const std::optional<EcPointT> point = ReadPoint(points, i);
+                const ValueType scalar = ReadValue(scalars, i);
+                WritePoint(
+                    point ? EcPointT::MultiScalarMultiply(
+                                gsl::make_span(&*point, 1), gsl::make_span(&scalar, 1),
+                                GetEcConstants().k_alpha)
+                          : std::nullopt,
+                    out, i);
+              },
+              statuses);
+        },
+        kMinEcMultiplicationsPerThread);
+  } catch (...) {
+    return 1;
+  }
+  return 0;
+}
+
+extern "C" int EcMulGeneratorBatch(
+    const gsl::byte* scalars, size_t n, size_t n_threads, gsl::byte* out, gsl::byte* statuses) {
+  using FractionFieldElementT = FractionFieldElement<PrimeFieldElement>;
+  try {
+    ParallelFor(
+        n, n_threads,
+        [&](size_t begin, size_t end) {
+          // The x coordinates of the non-zero results, followed by their y coordinates.
+          std::vector<size_t> indices;
+          std::vector<FractionFieldElementT> fraction_xs, fraction_ys;
+          indices.reserve(end - begin);
+          fraction_xs.reserve(2 * (end - begin));
+          fraction_ys.reserve(end - begin);
+          for (size_t i = begin; i < end; ++i) {
+            statuses[i] = gsl::byte{BATCH_STATUS_OK};
+            const auto point = GetGeneratorTable().Multiply(ReadValue(scalars, i));
+            if (!point) {
+              WritePoint(std::nullopt, out, i);
+              continue;
+            }
+            indices.push_back(i);
+            fraction_xs.push_back(point->x);
+            fraction_ys.push_back(point->y);
+          }
+          fraction_xs.insert(fraction_xs.end(), fraction_ys.begin(), fraction_ys.end());
+          std::vector<PrimeFieldElement> coordinates(
+              fraction_xs.size(), PrimeFieldElement::Zero());
+          FractionFieldElementT::BatchToBaseFieldElement(fraction_xs, coordinates);
+          for (size_t j = 0; j < indices.size(); ++j) {
+            WritePoint(EcPointT(coordinates[j], coordinates[indices.size() + j]), out, indices[j]);
+          }
+        },
+        kMinKeysPerThread);
+  } catch (...) {
+    return 1;
+  }
+  return 0;
+}
+
+extern "C" int FieldMulBatchWithFormat(
+    const gsl::byte* as, const gsl::byte* bs, size_t n, size_t n_threads, int format,
+    gsl::byte* out, gsl::byte* statuses) {
+  try {
+    const ElementFormat element_format = ToElementFormat(format);
+    const auto multiply = [&](size_t begin, size_t end) {
+      std::vector<PrimeFieldElement> products = ReadElements(as, begin, end, element_format);
+      const std::vector<PrimeFieldElement> chunk_bs = ReadElements(bs, begin, end, element_format);
+      for (size_t i = 0; i < products.size(); ++i) {
+        products[i] = products[i] * chunk_bs[i];
+      }
+      WriteElements(products, element_format, out, begin);
+    };
+    ParallelFor(
+        n, n_threads,
+        [&](size_t begin, size_t end) {
+          ProcessChunk(
+              begin, end, multiply,
+              [&](size_t i) {
+                ZeroElement(out, i);
+                multiply(i, i + 1);
+              },
+              statuses);
+        },
+        kMinFieldMultiplicationsPerThread);
+  } catch (...) {
+    return 1;
+  }
+  return 0;
+}
+
+extern "C" int FieldMulBatch(
+    const gsl::byte* as, const gsl::byte* bs, size_t n, size_t n_threads, gsl::byte* out,
+    gsl::byte* statuses) {
+  return FieldMulBatchWithFormat(as, bs, n, n_threads, ELEMENT_FORMAT_STANDARD, out, statuses);
+}
+
+extern "C" int FieldInvBatchWithFormat(
+    const gsl::byte* as, size_t n, size_t n_threads, int format, gsl::byte* out,
+    gsl::byte* statuses) {
+  try {
+    const ElementFormat element_format = ToElementFormat(format);
+    const auto invert = [&](size_t begin, size_t end) {
+      const std::vector<PrimeFieldElement> elements = ReadElements(as, begin, end, element_format);
+      ASSERT(
+          std::find(elements.begin(), elements.end(), PrimeFieldElement::Zero()) == elements.end(),
+          "Zero does not have an inverse.");
+      std::vector<PrimeFieldElement> inverses(elements.size(), PrimeFieldElement::Zero());
+      BatchInverse<PrimeFieldElement>(elements, inverses);
+      WriteElements(inverses, element_format, out, begin);
+    };
+    ParallelFor(
+        n, n_threads,
+        [&](size_t begin, size_t end) {
+          ProcessChunk(
+              begin, end, invert,
+              [&](size_t i) {
+                ZeroElement(out, i);
+                invert(i, i + 1);
+              },
+              statuses);
+        },
+        kMinFieldInversionsPerThread);
+  } catch (...) {
+    return 1;
+  }
+  return 0;
+}
+
+extern "C" int FieldInvBatch(
+    const gsl::byte* as, size_t n, size_t n_threads, gsl::byte* out, gsl::byte* statuses) {
+  return FieldInvBatchWithFormat(as, n, n_threads, ELEMENT_FORMAT_STANDARD, out, statuses);
+}
+
+}  // namespace starkware
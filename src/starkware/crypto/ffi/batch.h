@@ -0,0 +1,127 @@
+#ifndef STARKWARE_CRYPTO_FFI_BATCH_H_
+#define STARKWARE_CRYPTO_FFI_BATCH_H_
+
+#include <stddef.h>
+
+/*
+  Batch versions of the exports in pedersen_hash.h, ecdsa.h and arithmetic.h.
+
+  Every input and output is a contiguous array of n elements, each of 32 bytes in little-endian
+  (the format of the single-item exports), or of n points, each of 64 bytes (see arithmetic.h).
+  For every item, statuses[i] is set to one of the BatchStatus values. Outputs of items whose
+  status is not BATCH_STATUS_OK are zeroed.
+  The functions return 0 if the batch was processed, and a nonzero value otherwise (e.g., if
+  memory could not be allocated), in which case statuses and the outputs are unspecified.
+*/
+
+enum BatchStatus {
+  BATCH_STATUS_OK = 0,
+  // The signature is well formed, but invalid (VerifyBatch() only).
+  BATCH_STATUS_INVALID_SIGNATURE = 1,
+  // The input of the item was rejected (e.g., a zero message hash, a stark key or a point that is
+  // not on the curve, or a zero field element to invert), or no signature exists for the given k.
+  BATCH_STATUS_INVALID_INPUT = 2,
+};
+
+/*
+  The encoding of field elements in the *WithFormat() functions.
+*/
+enum ElementFormat {
+  // The value in little-endian (the format of all the other exports).
+  ELEMENT_FORMAT_STANDARD = 0,
+  // The Montgomery representation of the element (i.e., the value multiplied by 2^256 modulo the
+  // prime) in little-endian. This is the library's internal representation, so elements in this
+  // format are neither converted on input nor on output. Meant for passing the elements between
+  // services that use this library, which convert them from and to the standard format only at
+  // the boundaries (see ConvertElements()).
+  ELEMENT_FORMAT_MONTGOMERY = 1,
+};
+
+/*
+  Converts n field elements from the format from_format to the format to_format (see
+  ElementFormat).
+*/
+int ConvertElements(
+    const char* elements, size_t n, size_t n_threads, int from_format, int to_format, char* out,
+    char* statuses);
+
+/*
+  out[i] = Hash(xs[i], ys[i]).
+*/
+int HashBatch(
+    const char* xs, const char* ys, size_t n, size_t n_threads, char* out, char* statuses);
+
+/*
+  Same as HashBatch(), except that xs, ys and out are in the given ElementFormat.
+*/
+int HashBatchWithFormat(
+    const char* xs, const char* ys, size_t n, size_t n_threads, int format, char* out,
+    char* statuses);
+
+/*
+  Verifies the signatures signatures[i] of msg_hashes[i] with stark_keys[i]. Every signature is of
+  64 bytes: r followed by w, as in the output of SignBatch().
+*/
+int VerifyBatch(
+    const char* stark_keys, const char* msg_hashes, const char* signatures, size_t n,
+    size_t n_threads, char* statuses);
+
+/*
+  Signs messages[i] with private_keys[i] and the nonce ks[i]. out[i] is of 64 bytes: r followed by
+  w, as in Sign().
+*/
+int SignBatch(
+    const char* private_keys, const char* messages, const char* ks, size_t n, size_t n_threads,
+    char* out, char* statuses);
+
+/*
+  out[i] = GetPublicKey(private_keys[i]).
+*/
+int GetPublicKeyBatch(
+    const char* private_keys, size_t n, size_t n_threads, char* out, char* statuses);
+
+/*
+  out[i] = EcAdd(ps[i], qs[i]).
+*/
+int EcAddBatch(
+    const char* ps, const char* qs, size_t n, size_t n_threads, char* out, char* statuses);
+
+/*
+  out[i] = EcMul(points[i], scalars[i]).
+*/
+int EcMulBatch(
+    const char* points, const char* scalars, size_t n, size_t n_threads, char* out,
+    char* statuses);
+
+/*
+  out[i] = EcMulGenerator(scalars[i]). The conversion of the results to affine coordinates takes a
+  single field inversion per thread.
+*/
+int EcMulGeneratorBatch(
+    const char* scalars, size_t n, size_t n_threads, char* out, char* statuses);
+
+/*
+  out[i] = FieldMul(as[i], bs[i]).
+*/
+int FieldMulBatch(
+    const char* as, const char* bs, size_t n, size_t n_threads, char* out, char* statuses);
+
+/*
+  Same as FieldMulBatch(), except that as, bs and out are in the given ElementFormat.
+*/
+int FieldMulBatchWithFormat(
+    const char* as, const char* bs, size_t n, size_t n_threads, int format, char* out,
+    char* statuses);
+
+/*
+  out[i] = FieldInv(as[i]). Takes a single field inversion per thread (see BatchInverse()).
+*/
+int FieldInvBatch(const char* as, size_t n, size_t n_threads, char* out, char* statuses);
+
+/*
+  Same as FieldInvBatch(), except that as and out are in the given ElementFormat.
+*/
+int FieldInvBatchWithFormat(
+    const char* as, size_t n, size_t n_threads, int format, char* out, char* statuses);
+
+#endif  // STARKWARE_CRYPTO_FFI_BATCH_H_
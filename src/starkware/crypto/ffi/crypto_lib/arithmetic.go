@@ -0,0 +1,182 @@
+package crypto_lib
+
+import "errors"
+
+/*
+
+#cgo CFLAGS: -I.
+#cgo LDFLAGS: -L./.. -lcrypto_c_exports -Wl,-rpath=./.
+#include "../arithmetic.h"
+#include "../batch.h"
+
+*/
+import "C"
+import "unsafe"
+
+/*
+  A point of the STARK curve, in the format of the C exports (see arithmetic.h). The curve's zero
+  element is (0, 0).
+*/
+type Point struct {
+	X Element
+	Y Element
+}
+
+func elementPtr(element *Element) *C.char {
+	return (*C.char)(unsafe.Pointer(&element[0]))
+}
+
+func pointPtr(point *Point) *C.char {
+	return (*C.char)(unsafe.Pointer(&point.X[0]))
+}
+
+func pointsPtr(points []Point) *C.char {
+	if len(points) == 0 {
+		return nil
+	}
+	return pointPtr(&points[0])
+}
+
+func checkError(res C.int) error {
+	if res != C.CRYPTO_OK {
+		return errors.New("crypto_lib: " + C.GoString(C.GetLastErrorMessage()))
+	}
+	return nil
+}
+
+/*
+  Returns p + q.
+*/
+func EcAdd(p, q Point) (Point, error) {
+	var out Point
+	err := checkError(C.EcAdd(pointPtr(&p), pointPtr(&q), pointPtr(&out)))
+	return out, err
+}
+
+/*
+  Returns scalar * p.
+*/
+func EcMul(p Point, scalar Element) (Point, error) {
+	var out Point
+	err := checkError(C.EcMul(pointPtr(&p), elementPtr(&scalar), pointPtr(&out)))
+	return out, err
+}
+
+/*
+  Returns scalar * G, where G is the generator of the curve.
+*/
+func EcMulGenerator(scalar Element) (Point, error) {
+	var out Point
+	err := checkError(C.EcMulGenerator(elementPtr(&scalar), pointPtr(&out)))
+	return out, err
+}
+
+/*
+  Returns a * b in the field of the curve.
+*/
+func FieldMul(a, b Element) (Element, error) {
+	var out Element
+	err := checkError(C.FieldMul(elementPtr(&a), elementPtr(&b), elementPtr(&out)))
+	return out, err
+}
+
+/*
+  Returns a^-1 in the field of the curve. a must not be zero. The running time depends on a, so a
+  should not be secret.
+*/
+func FieldInv(a Element) (Element, error) {
+	var out Element
+	err := checkError(C.FieldInv(elementPtr(&a), elementPtr(&out)))
+	return out, err
+}
+
+/*
+  Sets out[i] to ps[i] + qs[i] (see EcAdd()).
+*/
+func EcAddBatch(ps, qs, out []Point, statuses []Status) error {
+	n := len(ps)
+	if len(qs) != n || len(out) != n || len(statuses) != n {
+		return errLengthMismatch
+	}
+	return checkResult(C.EcAddBatch(
+		pointsPtr(ps), pointsPtr(qs), C.size_t(n), numThreads(), pointsPtr(out),
+		statusesPtr(statuses)))
+}
+
+/*
+  Sets out[i] to scalars[i] * points[i] (see EcMul()).
+*/
+func EcMulBatch(points []Point, scalars []Element, out []Point, statuses []Status) error {
+	n := len(points)
+	if len(scalars) != n || len(out) != n || len(statuses) != n {
+		return errLengthMismatch
+	}
+	return checkResult(C.EcMulBatch(
+		pointsPtr(points), elementsPtr(scalars), C.size_t(n), numThreads(), pointsPtr(out),
+		statusesPtr(statuses)))
+}
+
+/*
+  Sets out[i] to scalars[i] * G (see EcMulGenerator()).
+*/
+func EcMulGeneratorBatch(scalars []Element, out []Point, statuses []Status) error {
+	n := len(scalars)
+	if len(out) != n || len(statuses) != n {
+		return errLengthMismatch
+	}
+	return checkResult(C.EcMulGeneratorBatch(
+		elementsPtr(scalars), C.size_t(n), numThreads(), pointsPtr(out), statusesPtr(statuses)))
+}
+
+/*
+  Sets out[i] to as[i] * bs[i] (see FieldMul()).
+*/
+func FieldMulBatch(as, bs, out []Element, statuses []Status) error {
+	n := len(as)
+	if len(bs) != n || len(out) != n || len(statuses) != n {
+		return errLengthMismatch
+	}
+	return checkResult(C.FieldMulBatch(
+		elementsPtr(as), elementsPtr(bs), C.size_t(n), numThreads(), elementsPtr(out),
+		statusesPtr(statuses)))
+}
+
+/*
+  Same as FieldMulBatch(), except that as, bs and out are in the given format.
+*/
+func FieldMulBatchWithFormat(
+	as, bs []Element, format ElementFormat, out []Element, statuses []Status) error {
+	n := len(as)
+	if len(bs) != n || len(out) != n || len(statuses) != n {
+		return errLengthMismatch
+	}
+	return checkResult(C.FieldMulBatchWithFormat(
+		elementsPtr(as), elementsPtr(bs), C.size_t(n), numThreads(), C.int(format),
+		elementsPtr(out), statusesPtr(statuses)))
+}
+
+/*
+  Sets out[i] to as[i]^-1 (see FieldInv()).
+*/
+func FieldInvBatch(as, out []Element, statuses []Status) error {
+	n := len(as)
+	if len(out) != n || len(statuses) != n {
+		return errLengthMismatch
+	}
+	return checkResult(C.FieldInvBatch(
+		elementsPtr(as), C.size_t(n), numThreads(), elementsPtr(out), statusesPtr(statuses)))
+}
+
+/*
+  Same as FieldInvBatch(), except that as and out are in the given format.
+*/
+func FieldInvBatchWithFormat(
+	as []Element, format ElementFormat, out []Element, statuses []Status) error {
+	n := len(as)
+	if len(out) != n || len(statuses) != n {
+		return errLengthMismatch
+	}
+	return checkResult(C.FieldInvBatchWithFormat(
+		elementsPtr(as), C.size_t(n), numThreads(), C.int(format), elementsPtr(out),
+		statusesPtr(statuses)))
+}
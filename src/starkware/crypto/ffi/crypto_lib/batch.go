@@ -0,0 +1,214 @@
+package crypto_lib
+
+import (
+	"errors"
+	"math/big"
+	"runtime"
+)
+
+/*
+
+#cgo CFLAGS: -I.
+#cgo LDFLAGS: -L./.. -lcrypto_c_exports -Wl,-rpath=./.
+#include "../batch.h"
+
+*/
+import "C"
+import "unsafe"
+
+/*
+  A field element or a scalar, as 32 bytes in little-endian. This is the format of the C exports,
+  so slices of elements are passed to them as is, without copying or converting.
+*/
+type Element [32]byte
+
+/*
+  A signature (r, w), where w = s^-1 modulo the order of the curve. This is the format the C
+  exports use, so no modular inversion is needed to pass a signature to the library.
+*/
+type Signature struct {
+	R Element
+	W Element
+}
+
+/*
+  The status of an item of a batch function.
+*/
+type Status uint8
+
+const (
+	StatusOk               Status = C.BATCH_STATUS_OK
+	StatusInvalidSignature Status = C.BATCH_STATUS_INVALID_SIGNATURE
+	StatusInvalidInput     Status = C.BATCH_STATUS_INVALID_INPUT
+)
+
+/*
+  The encoding of the elements of the *WithFormat() functions (see ElementFormat in batch.h).
+  FormatMontgomery is the library's internal representation, so elements in that format are passed
+  to and from it without any conversion. Use it between services, and convert the elements from
+  and to FormatStandard only at the boundaries (see ConvertElements()).
+*/
+type ElementFormat C.int
+
+const (
+	FormatStandard   ElementFormat = C.ELEMENT_FORMAT_STANDARD
+	FormatMontgomery ElementFormat = C.ELEMENT_FORMAT_MONTGOMERY
+)
+
+// The order of the curve, which is the modulus of the s and w of signatures.
+var curveOrder, _ = new(big.Int).SetString(
+	"800000000000010ffffffffffffffffb781126dcae7b2321e66a241adc64d2f", 16)
+
+var errLengthMismatch = errors.New("crypto_lib: the lengths of the arguments mismatch")
+var errBatchFailed = errors.New("crypto_lib: the batch could not be processed")
+var errSOutOfRange = errors.New("crypto_lib: s must be in the range [1, curve order)")
+
+/*
+  Returns x as an element. x must be non-negative and smaller than 2^256.
+*/
+func ElementFromBigInt(x *big.Int) Element {
+	var element Element
+	x.FillBytes(element[:])
+	for i, j := 0, len(element)-1; i < j; i, j = i+1, j-1 {
+		element[i], element[j] = element[j], element[i]
+	}
+	return element
+}
+
+/*
+  Returns the value of the element.
+*/
+func (element Element) BigInt() *big.Int {
+	var big_endian Element
+	for i := range element {
+		big_endian[len(element)-1-i] = element[i]
+	}
+	return new(big.Int).SetBytes(big_endian[:])
+}
+
+/*
+  Converts a signature (r, s) to (r, w). Use it once per signature that is verified more than once.
+  Returns an error if s is not in the range [1, curve order), since it has no inverse w.
+*/
+func SignatureFromRS(r, s *big.Int) (Signature, error) {
+	if s.Sign() <= 0 || s.Cmp(curveOrder) >= 0 {
+		return Signature{}, errSOutOfRange
+	}
+	w := new(big.Int).ModInverse(s, curveOrder)
+	return Signature{ElementFromBigInt(r), ElementFromBigInt(w)}, nil
+}
+
+func elementsPtr(elements []Element) *C.char {
+	if len(elements) == 0 {
+		return nil
+	}
+	return (*C.char)(unsafe.Pointer(&elements[0]))
+}
+
+func signaturesPtr(sigs []Signature) *C.char {
+	if len(sigs) == 0 {
+		return nil
+	}
+	return (*C.char)(unsafe.Pointer(&sigs[0]))
+}
+
+func statusesPtr(statuses []Status) *C.char {
+	if len(statuses) == 0 {
+		return nil
+	}
+	return (*C.char)(unsafe.Pointer(&statuses[0]))
+}
+
+func numThreads() C.size_t {
+	return C.size_t(runtime.GOMAXPROCS(0))
+}
+
+func checkResult(res C.int) error {
+	if res != 0 {
+		return errBatchFailed
+	}
+	return nil
+}
+
+/*
+  Sets out[i] to the Pedersen hash of xs[i] and ys[i] (see Hash()).
+*/
+func HashBatch(xs, ys, out []Element, statuses []Status) error {
+	n := len(xs)
+	if len(ys) != n || len(out) != n || len(statuses) != n {
+		return errLengthMismatch
+	}
+	return checkResult(C.HashBatch(
+		elementsPtr(xs), elementsPtr(ys), C.size_t(n), numThreads(), elementsPtr(out),
+		statusesPtr(statuses)))
+}
+
+/*
+  Converts elements from the format from to the format to.
+*/
+func ConvertElements(
+	elements []Element, from, to ElementFormat, out []Element, statuses []Status) error {
+	n := len(elements)
+	if len(out) != n || len(statuses) != n {
+		return errLengthMismatch
+	}
+	return checkResult(C.ConvertElements(
+		elementsPtr(elements), C.size_t(n), numThreads(), C.int(from), C.int(to), elementsPtr(out),
+		statusesPtr(statuses)))
+}
+
+/*
+  Same as HashBatch(), except that xs, ys and out are in the given format.
+*/
+func HashBatchWithFormat(
+	xs, ys []Element, format ElementFormat, out []Element, statuses []Status) error {
+	n := len(xs)
+	if len(ys) != n || len(out) != n || len(statuses) != n {
+		return errLengthMismatch
+	}
+	return checkResult(C.HashBatchWithFormat(
+		elementsPtr(xs), elementsPtr(ys), C.size_t(n), numThreads(), C.int(format),
+		elementsPtr(out), statusesPtr(statuses)))
+}
+
+/*
+  Verifies the signatures sigs[i] of msg_hashes[i] with stark_keys[i] (see Verify()). The status of
+  a valid signature is StatusOk.
+*/
+func VerifyBatch(stark_keys, msg_hashes []Element, sigs []Signature, statuses []Status) error {
+	n := len(stark_keys)
+	if len(msg_hashes) != n || len(sigs) != n || len(statuses) != n {
+		return errLengthMismatch
+	}
+	return checkResult(C.VerifyBatch(
+		elementsPtr(stark_keys), elementsPtr(msg_hashes), signaturesPtr(sigs), C.size_t(n),
+		numThreads(), statusesPtr(statuses)))
+}
+
+/*
+  Signs messages[i] with private_keys[i] and the nonce ks[i] (see Sign()).
+
+  NOTE: the nonces should be strong cryptographical randoms, and must not repeat.
+*/
+func SignBatch(private_keys, messages, ks []Element, out []Signature, statuses []Status) error {
+	n := len(private_keys)
+	if len(messages) != n || len(ks) != n || len(out) != n || len(statuses) != n {
+		return errLengthMismatch
+	}
+	return checkResult(C.SignBatch(
+		elementsPtr(private_keys), elementsPtr(messages), elementsPtr(ks), C.size_t(n),
+		numThreads(), signaturesPtr(out), statusesPtr(statuses)))
+}
+
+/*
+  Sets out[i] to the stark key of private_keys[i] (see GetPublicKey()).
+*/
+func GetPublicKeyBatch(private_keys, out []Element, statuses []Status) error {
+	n := len(private_keys)
+	if len(out) != n || len(statuses) != n {
+		return errLengthMismatch
+	}
+	return checkResult(C.GetPublicKeyBatch(
+		elementsPtr(private_keys), C.size_t(n), numThreads(), elementsPtr(out),
+		statusesPtr(statuses)))
+}
@@ -1,7 +1,11 @@
 package main
 
 import "./crypto_lib"
-import "testing"
+import (
+	"fmt"
+	"math/big"
+	"testing"
+)
 
 func TestHash(t *testing.T) {
     res := crypto_lib.Hash(
@@ -12,6 +16,13 @@ func TestHash(t *testing.T) {
     if res != expected_hash {
         t.Errorf("Hash error: expected %s but got %s.", expected_hash, res)
     }
+
+	if crypto_lib.Hash("0x1", "0x2") != crypto_lib.Hash(padHex("0x1"), padHex("0x2")) {
+		t.Errorf("Hash error: the result depends on the padding of the input.")
+	}
+	if crypto_lib.Hash("0x12g", "0x1") != "" {
+		t.Errorf("Hash error: an invalid hex string was accepted.")
+	}
 }
 
 func TestGetPublicKey(t *testing.T) {
@@ -59,3 +70,270 @@ func TestSign(t *testing.T) {
 		t.Errorf("Sign error: signature rejected by verification.")
 	}
 }
+
+func toElement(s string) crypto_lib.Element {
+	x, _ := new(big.Int).SetString(s[2:], 16)
+	return crypto_lib.ElementFromBigInt(x)
+}
+
+func toHex(element crypto_lib.Element) string {
+	return fmt.Sprintf("0x%064x", element.BigInt())
+}
+
+func TestBatch(t *testing.T) {
+	const n = 3
+	private_keys := []string{"0x1", "0x12", "0x3c1e9550e66958296d11b60f8e8e7a7ad990d07fa65d5f7652c4a6c87d4e3cc"}
+	messages := []string{"0x2", "0x3", "0x397e76d1667c4454bfb83514e120583af836f8e32a516765497823eabe16a3f"}
+	ks := []string{"0x3", "0x4", "0x5"}
+	private_key_elements := make([]crypto_lib.Element, n)
+	message_elements := make([]crypto_lib.Element, n)
+	k_elements := make([]crypto_lib.Element, n)
+	for i := 0; i < n; i++ {
+		private_key_elements[i] = toElement(private_keys[i])
+		message_elements[i] = toElement(messages[i])
+		k_elements[i] = toElement(ks[i])
+	}
+	statuses := make([]crypto_lib.Status, n)
+
+	hashes := make([]crypto_lib.Element, n)
+	if err := crypto_lib.HashBatch(private_key_elements, message_elements, hashes, statuses); err != nil {
+		t.Fatalf("HashBatch error: %v", err)
+	}
+	stark_keys := make([]crypto_lib.Element, n)
+	if err := crypto_lib.GetPublicKeyBatch(private_key_elements, stark_keys, statuses); err != nil {
+		t.Fatalf("GetPublicKeyBatch error: %v", err)
+	}
+	sigs := make([]crypto_lib.Signature, n)
+	if err := crypto_lib.SignBatch(
+		private_key_elements, message_elements, k_elements, sigs, statuses); err != nil {
+		t.Fatalf("SignBatch error: %v", err)
+	}
+	for i := 0; i < n; i++ {
+		if statuses[i] != crypto_lib.StatusOk {
+			t.Errorf("SignBatch error: unexpected status %d.", statuses[i])
+		}
+		if toHex(hashes[i]) != crypto_lib.Hash(padHex(private_keys[i]), padHex(messages[i])) {
+			t.Errorf("HashBatch error: hash %d differs from Hash().", i)
+		}
+		if toHex(stark_keys[i]) != crypto_lib.GetPublicKey(private_keys[i]) {
+			t.Errorf("GetPublicKeyBatch error: key %d differs from GetPublicKey().", i)
+		}
+		r, s := crypto_lib.Sign(private_keys[i], messages[i], ks[i])
+		sig, err := crypto_lib.SignatureFromRS(toElement(r).BigInt(), toElement(s).BigInt())
+		if err != nil || sig != sigs[i] {
+			t.Errorf("SignBatch error: signature %d differs from Sign().", i)
+		}
+	}
+	// s = 0 and s = 2^252 (which is larger than the order of the curve) have no inverse.
+	for _, s := range []*big.Int{big.NewInt(0), new(big.Int).Lsh(big.NewInt(1), 252)} {
+		if _, err := crypto_lib.SignatureFromRS(big.NewInt(1), s); err == nil {
+			t.Errorf("SignatureFromRS error: s = %v was accepted.", s)
+		}
+	}
+
+	// Corrupt the last signature.
+	sigs[n-1].W[0] ^= 1
+	if err := crypto_lib.VerifyBatch(stark_keys, message_elements, sigs, statuses); err != nil {
+		t.Fatalf("VerifyBatch error: %v", err)
+	}
+	for i := 0; i < n-1; i++ {
+		if statuses[i] != crypto_lib.StatusOk {
+			t.Errorf("VerifyBatch error: valid signature %d was rejected.", i)
+		}
+	}
+	if statuses[n-1] != crypto_lib.StatusInvalidSignature {
+		t.Errorf("VerifyBatch error: invalid signature was not rejected.")
+	}
+
+	// Values that are not field elements fail their own signature, and not the whole batch.
+	prime, _ := new(big.Int).SetString(
+		"800000000000011000000000000000000000000000000000000000000000001", 16)
+	stark_keys[0] = crypto_lib.ElementFromBigInt(prime)
+	sigs[1].R = crypto_lib.ElementFromBigInt(
+		new(big.Int).Sub(new(big.Int).Lsh(big.NewInt(1), 256), big.NewInt(1)))
+	if err := crypto_lib.VerifyBatch(stark_keys, message_elements, sigs, statuses); err != nil {
+		t.Fatalf("VerifyBatch error: %v", err)
+	}
+	expected := []crypto_lib.Status{
+		crypto_lib.StatusInvalidInput, crypto_lib.StatusInvalidInput,
+		crypto_lib.StatusInvalidSignature}
+	for i := 0; i < n; i++ {
+		if statuses[i] != expected[i] {
+			t.Errorf("VerifyBatch error: unexpected status %d for signature %d.", statuses[i], i)
+		}
+	}
+}
+
+func TestArithmetic(t *testing.T) {
+	one := crypto_lib.ElementFromBigInt(big.NewInt(1))
+	two := crypto_lib.ElementFromBigInt(big.NewInt(2))
+	g, err := crypto_lib.EcMulGenerator(one)
+	if err != nil || toHex(g.X) != crypto_lib.GetPublicKey("0x1") {
+		t.Fatalf("EcMulGenerator error: %v", err)
+	}
+	g2, _ := crypto_lib.EcMulGenerator(two)
+	if sum, err := crypto_lib.EcAdd(g, g); err != nil || sum != g2 {
+		t.Errorf("EcAdd error: G + G differs from 2 * G (%v).", err)
+	}
+	if product, err := crypto_lib.EcMul(g, two); err != nil || product != g2 {
+		t.Errorf("EcMul error: 2 * G differs from EcMulGenerator(2) (%v).", err)
+	}
+	prime, _ := new(big.Int).SetString(
+		"800000000000011000000000000000000000000000000000000000000000001", 16)
+	minus_g := crypto_lib.Point{
+		g.X, crypto_lib.ElementFromBigInt(new(big.Int).Sub(prime, g.Y.BigInt()))}
+	if sum, err := crypto_lib.EcAdd(g, minus_g); err != nil || sum != (crypto_lib.Point{}) {
+		t.Errorf("EcAdd error: G - G is not the zero element (%v).", err)
+	}
+	if _, err := crypto_lib.EcAdd(g, crypto_lib.Point{one, one}); err == nil {
+		t.Errorf("EcAdd error: a point that is not on the curve was accepted.")
+	}
+
+	inverse, err := crypto_lib.FieldInv(g.X)
+	if product, _ := crypto_lib.FieldMul(g.X, inverse); err != nil || product != one {
+		t.Errorf("FieldInv error: x * x^-1 is not 1 (%v).", err)
+	}
+	if _, err := crypto_lib.FieldInv(crypto_lib.Element{}); err == nil {
+		t.Errorf("FieldInv error: zero was inverted.")
+	}
+
+	points := make([]crypto_lib.Point, 2)
+	statuses := make([]crypto_lib.Status, 2)
+	if err := crypto_lib.EcMulGeneratorBatch(
+		[]crypto_lib.Element{one, two}, points, statuses); err != nil || points[0] != g ||
+		points[1] != g2 {
+		t.Errorf("EcMulGeneratorBatch error: results differ from EcMulGenerator() (%v).", err)
+	}
+	inverses := make([]crypto_lib.Element, 2)
+	if err := crypto_lib.FieldInvBatch(
+		[]crypto_lib.Element{g.X, {}}, inverses, statuses); err != nil || inverses[0] != inverse ||
+		statuses[0] != crypto_lib.StatusOk || statuses[1] != crypto_lib.StatusInvalidInput {
+		t.Errorf("FieldInvBatch error: unexpected results (%v).", err)
+	}
+}
+
+func TestElementFormat(t *testing.T) {
+	const n = 3
+	xs := benchmarkElements(0)[:n]
+	ys := benchmarkElements(100)[:n]
+	statuses := make([]crypto_lib.Status, n)
+	hashes := make([]crypto_lib.Element, n)
+	if err := crypto_lib.HashBatch(xs, ys, hashes, statuses); err != nil {
+		t.Fatalf("HashBatch error: %v", err)
+	}
+
+	montgomery_xs := make([]crypto_lib.Element, n)
+	montgomery_ys := make([]crypto_lib.Element, n)
+	crypto_lib.ConvertElements(
+		xs, crypto_lib.FormatStandard, crypto_lib.FormatMontgomery, montgomery_xs, statuses)
+	crypto_lib.ConvertElements(
+		ys, crypto_lib.FormatStandard, crypto_lib.FormatMontgomery, montgomery_ys, statuses)
+	montgomery_hashes := make([]crypto_lib.Element, n)
+	if err := crypto_lib.HashBatchWithFormat(
+		montgomery_xs, montgomery_ys, crypto_lib.FormatMontgomery, montgomery_hashes,
+		statuses); err != nil {
+		t.Fatalf("HashBatchWithFormat error: %v", err)
+	}
+	converted := make([]crypto_lib.Element, n)
+	crypto_lib.ConvertElements(
+		montgomery_hashes, crypto_lib.FormatMontgomery, crypto_lib.FormatStandard, converted,
+		statuses)
+	for i := 0; i < n; i++ {
+		if montgomery_xs[i] == xs[i] || converted[i] != hashes[i] {
+			t.Errorf("HashBatchWithFormat error: hash %d differs from HashBatch().", i)
+		}
+	}
+}
+
+func padHex(s string) string {
+	return fmt.Sprintf("0x%064s", s[2:])
+}
+
+/*
+  The benchmarks below compare the string API with the batch API. Every iteration (op) is a single
+  item, so the ns/op of the two APIs are comparable.
+*/
+
+const benchmarkBatchSize = 256
+
+func benchmarkElements(offset int64) []crypto_lib.Element {
+	elements := make([]crypto_lib.Element, benchmarkBatchSize)
+	for i := range elements {
+		elements[i] = crypto_lib.ElementFromBigInt(big.NewInt(offset + int64(i) + 1))
+	}
+	return elements
+}
+
+func BenchmarkHash(b *testing.B) {
+	for i := 0; i < b.N; i++ {
+		crypto_lib.Hash(padHex(fmt.Sprintf("0x%x", i+1)), padHex("0x2"))
+	}
+}
+
+func BenchmarkHashBatch(b *testing.B) {
+	xs := benchmarkElements(0)
+	ys := benchmarkElements(1000)
+	out := make([]crypto_lib.Element, benchmarkBatchSize)
+	statuses := make([]crypto_lib.Status, benchmarkBatchSize)
+	b.ResetTimer()
+	for i := 0; i < b.N; i += benchmarkBatchSize {
+		crypto_lib.HashBatch(xs, ys, out, statuses)
+	}
+}
+
+func BenchmarkGetPublicKey(b *testing.B) {
+	for i := 0; i < b.N; i++ {
+		crypto_lib.GetPublicKey(fmt.Sprintf("0x%x", i+1))
+	}
+}
+
+func BenchmarkGetPublicKeyBatch(b *testing.B) {
+	private_keys := benchmarkElements(0)
+	out := make([]crypto_lib.Element, benchmarkBatchSize)
+	statuses := make([]crypto_lib.Status, benchmarkBatchSize)
+	b.ResetTimer()
+	for i := 0; i < b.N; i += benchmarkBatchSize {
+		crypto_lib.GetPublicKeyBatch(private_keys, out, statuses)
+	}
+}
+
+func BenchmarkSign(b *testing.B) {
+	for i := 0; i < b.N; i++ {
+		crypto_lib.Sign("0x1", fmt.Sprintf("0x%x", i+1), "0x3")
+	}
+}
+
+func BenchmarkSignBatch(b *testing.B) {
+	private_keys := benchmarkElements(0)
+	messages := benchmarkElements(1000)
+	ks := benchmarkElements(2000)
+	out := make([]crypto_lib.Signature, benchmarkBatchSize)
+	statuses := make([]crypto_lib.Status, benchmarkBatchSize)
+	b.ResetTimer()
+	for i := 0; i < b.N; i += benchmarkBatchSize {
+		crypto_lib.SignBatch(private_keys, messages, ks, out, statuses)
+	}
+}
+
+func BenchmarkVerify(b *testing.B) {
+	stark_key := crypto_lib.GetPublicKey("0x1")
+	r, s := crypto_lib.Sign("0x1", "0x2", "0x3")
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		crypto_lib.Verify(stark_key, "0x2", r, s)
+	}
+}
+
+func BenchmarkVerifyBatch(b *testing.B) {
+	private_keys := benchmarkElements(0)
+	messages := benchmarkElements(1000)
+	stark_keys := make([]crypto_lib.Element, benchmarkBatchSize)
+	sigs := make([]crypto_lib.Signature, benchmarkBatchSize)
+	statuses := make([]crypto_lib.Status, benchmarkBatchSize)
+	crypto_lib.GetPublicKeyBatch(private_keys, stark_keys, statuses)
+	crypto_lib.SignBatch(private_keys, messages, benchmarkElements(2000), sigs, statuses)
+	b.ResetTimer()
+	for i := 0; i < b.N; i += benchmarkBatchSize {
+		crypto_lib.VerifyBatch(stark_keys, messages, sigs, statuses)
+	}
+}
@@ -1,12 +1,17 @@
 #include "starkware/crypto/ffi/ecdsa.h"
 #include "starkware/crypto/ecdsa.h"
 
+#include <algorithm>
 #include <array>
+#include <utility>
+#include <vector>
 
 #include "third_party/gsl/gsl-lite.hpp"
 
 #include "starkware/algebra/prime_field_element.h"
+#include "starkware/crypto/elliptic_curve_constants.h"
 #include "starkware/crypto/ffi/utils.h"
+#include "starkware/utils/error_handling.h"
 
 namespace starkware {
 
@@ -18,12 +23,95 @@ constexpr size_t kElementSize = sizeof(ValueType);
 constexpr size_t kOutBufferSize = 1024;
 static_assert(kOutBufferSize >= kElementSize, "kOutBufferSize is not big enough");
 
+/*
+  Returns w = s^-1 modulo the order of the curve, for s in the range [1, order), and vice versa.
+*/
+ValueType InvertOnCurve(const ValueType& s) {
+  const auto& curve_order = GetEcConstants().k_order;
+  ASSERT(s != ValueType::Zero() && s < curve_order, "s must be in the range [1, curve order).");
+  return s.InvModPrimeVariableTime(curve_order);
+}
+
+/*
+  Converts the result of a verification to a CryptoError (see error.h).
+*/
+int ToCryptoError(VerifyStatus status) {
+  switch (status) {
+    case VerifyStatus::kValid:
+      return CRYPTO_OK;
+    case VerifyStatus::kInvalidSignature:
+      return SetLastError(CRYPTO_ERROR_INVALID_SIGNATURE, "Invalid signature.");
+    case VerifyStatus::kInvalidMessage:
+      return SetLastError(CRYPTO_ERROR_INVALID_INPUT, "Message hash is out of range.");
+    case VerifyStatus::kSignatureOutOfRange:
+      return SetLastError(CRYPTO_ERROR_INVALID_INPUT, "Signature is out of range.");
+    case VerifyStatus::kInvalidPublicKey:
+      return SetLastError(
+          CRYPTO_ERROR_INVALID_INPUT,
+          "Given public key does not correspond to a valid point on the elliptic curve.");
+  }
+  return SetLastError(CRYPTO_ERROR_INTERNAL, "Unknown verification status.");
+}
+
+PrimeFieldElement ReadElement(const gsl::byte bytes[kElementSize]) {
+  return PrimeFieldElement::FromBigInt(Deserialize(gsl::make_span(bytes, kElementSize)));
+}
+
+ValueType ReadValue(const gsl::byte bytes[kElementSize]) {
+  return Deserialize(gsl::make_span(bytes, kElementSize));
+}
+
+/*
+  Same as VerifyEcdsaPartialKeyChecked(), for values that are not yet converted to field elements.
+  Values that are not smaller than the field's prime are rejected with plain comparisons, before
+  the conversion, which would throw on them.
+*/
+VerifyStatus VerifyValues(
+    const ValueType& stark_key, const ValueType& msg_hash, const ValueType& r,
+    const ValueType& w) {
+  const auto& prime = PrimeFieldElement::kModulus;
+  if (msg_hash >= prime) {
+    return VerifyStatus::kInvalidMessage;
+  }
+  if (r >= prime || w >= prime) {
+    return VerifyStatus::kSignatureOutOfRange;
+  }
+  if (stark_key >= prime) {
+    return VerifyStatus::kInvalidPublicKey;
+  }
+  return VerifyEcdsaPartialKeyChecked(
+      PrimeFieldElement::FromBigInt(stark_key), PrimeFieldElement::FromBigInt(msg_hash),
+      {PrimeFieldElement::FromBigInt(r), PrimeFieldElement::FromBigInt(w)});
+}
+
+/*
+  Verifies the signature (r, s) of msg_hash with stark_key, where s = w^-1 modulo the order of the
+  curve, and returns a CryptoError.
+*/
+int VerifyRSValues(
+    const ValueType& stark_key, const ValueType& msg_hash, const ValueType& r,
+    const ValueType& s) {
+  if (s == ValueType::Zero() || s >= GetEcConstants().k_order) {
+    return SetLastError(CRYPTO_ERROR_INVALID_INPUT, "Signature is out of range.");
+  }
+  return ToCryptoError(VerifyValues(stark_key, msg_hash, r, InvertOnCurve(s)));
+}
+
+/*
+  Returns the signature (r, s) of message, where s = w^-1 modulo the order of the curve.
+*/
+std::pair<ValueType, ValueType> SignRSValues(
+    const ValueType& private_key, const ValueType& message, const ValueType& k) {
+  const auto sig = SignEcdsa(private_key, PrimeFieldElement::FromBigInt(message), k);
+  return {sig.first.ToStandardForm(), InvertOnCurve(sig.second.ToStandardForm())};
+}
+
 }  // namespace
 
 extern "C" int GetPublicKey(
     const gsl::byte private_key[kElementSize], gsl::byte out[kElementSize]) {
   try {
-    const auto stark_key = GetPublicKey(Deserialize(gsl::make_span(private_key, kElementSize))).x;
+    const auto stark_key = GetStarkKey(Deserialize(gsl::make_span(private_key, kElementSize)));
     Serialize(stark_key.ToStandardForm(), gsl::make_span(out, kElementSize));
   } catch (const std::exception& e) {
     return HandleError(e.what(), gsl::make_span(out, kOutBufferSize));
@@ -33,20 +121,84 @@ extern "C" int GetPublicKey(
   return 0;
 }
 
-extern "C" bool Verify(
+/*
+  Returns 1 if (r, w) is a valid signature of msg_hash with stark_key, and 0 otherwise.
+*/
+extern "C" int Verify(
     const gsl::byte stark_key[kElementSize], const gsl::byte msg_hash[kElementSize],
     const gsl::byte r_bytes[kElementSize], const gsl::byte w_bytes[kElementSize]) {
   try {
-    // The following call will throw in case of verification failure.
-    return VerifyEcdsaPartialKey(
-        PrimeFieldElement::FromBigInt(Deserialize(gsl::make_span(stark_key, kElementSize))),
-        PrimeFieldElement::FromBigInt(Deserialize(gsl::make_span(msg_hash, kElementSize))),
-        {PrimeFieldElement::FromBigInt(Deserialize(gsl::make_span(r_bytes, kElementSize))),
-         PrimeFieldElement::FromBigInt(Deserialize(gsl::make_span(w_bytes, kElementSize)))});
+    // Invalid input is rejected without throwing.
+    return VerifyValues(
+               ReadValue(stark_key), ReadValue(msg_hash), ReadValue(r_bytes),
+               ReadValue(w_bytes)) == VerifyStatus::kValid
+               ? 1
+               : 0;
+  } catch (...) {
+    return 0;
+  }
+}
+
+/*
+  Verifies n_requests signatures, using n_threads threads (see VerifyEcdsaParallel()). Every
+  request consists of the stark key, the message hash, r and w, in the format of Verify(). Sets
+  results[i] to 1 if the i-th signature is valid and to 0 otherwise.
+  Returns 0 on success, and a nonzero value if the requests could not be processed.
+*/
+extern "C" int VerifyParallel(
+    const gsl::byte* requests, size_t n_requests, size_t n_threads, gsl::byte* results) {
+  constexpr size_t kRequestSize = 4 * kElementSize;
+  try {
+    std::vector<VerifyRequest> parsed_requests;
+    parsed_requests.reserve(n_requests);
+    const auto requests_span = gsl::make_span(requests, n_requests * kRequestSize);
+    const PrimeFieldElement zero = PrimeFieldElement::Zero();
+    for (size_t i = 0; i < n_requests; ++i) {
+      const auto request = requests_span.subspan(i * kRequestSize, kRequestSize);
+      std::array<ValueType, 4> values;
+      for (size_t j = 0; j < values.size(); ++j) {
+        values[j] = Deserialize(request.subspan(j * kElementSize, kElementSize));
+      }
+      if (std::any_of(values.begin(), values.end(), [](const ValueType& value) {
+            return value >= PrimeFieldElement::kModulus;
+          })) {
+        // A value that is not a field element fails its request only. A request with w = 0 is
+        // rejected by VerifyEcdsaParallel().
+        parsed_requests.push_back({zero, zero, {zero, zero}});
+        continue;
+      }
+      const auto element = [&values](size_t j) { return PrimeFieldElement::FromBigInt(values[j]); };
+      parsed_requests.push_back({element(0), element(1), {element(2), element(3)}});
+    }
+    VerifyEcdsaParallel(
+        parsed_requests, gsl::make_span(reinterpret_cast<uint8_t*>(results), n_requests),
+        n_threads);
+  } catch (...) {
+    return 1;
+  }
+  return 0;
+}
+
+/*
+  Same as Verify(), except that the signature is given as (r, s), where s = w^-1 modulo the order of
+  the curve.
+*/
+extern "C" int VerifyRS(
+    const gsl::byte stark_key[kElementSize], const gsl::byte msg_hash[kElementSize],
+    const gsl::byte r_bytes[kElementSize], const gsl::byte s_bytes[kElementSize]) {
+  try {
+    const ValueType s = ReadValue(s_bytes);
+    if (s == ValueType::Zero() || s >= GetEcConstants().k_order) {
+      return 0;
+    }
+    return VerifyValues(
+               ReadValue(stark_key), ReadValue(msg_hash), ReadValue(r_bytes),
+               InvertOnCurve(s)) == VerifyStatus::kValid
+               ? 1
+               : 0;
   } catch (...) {
-    return false;
+    return 0;
   }
-  return true;
 }
 
 extern "C" int Sign(
@@ -68,4 +220,132 @@ extern "C" int Sign(
   return 0;
 }
 
+/*
+  Same as Sign(), except that the output is (r, s), where s = w^-1 modulo the order of the curve.
+*/
+extern "C" int SignRS(
+    const gsl::byte private_key[kElementSize], const gsl::byte message[kElementSize],
+    const gsl::byte k[kElementSize], gsl::byte out[kOutBufferSize]) {
+  try {
+    const auto sig = SignEcdsa(
+        Deserialize(gsl::make_span(private_key, kElementSize)),
+        PrimeFieldElement::FromBigInt(Deserialize(gsl::make_span(message, kElementSize))),
+        Deserialize(gsl::make_span(k, kElementSize)));
+
+    Serialize(sig.first.ToStandardForm(), gsl::make_span(out, kElementSize));
+    Serialize(
+        InvertOnCurve(sig.second.ToStandardForm()),
+        gsl::make_span(out + kElementSize, kElementSize));
+  } catch (const std::exception& e) {
+    return HandleError(e.what(), gsl::make_span(out, kOutBufferSize));
+  } catch (...) {
+    return HandleError("Unknown c++ exception.", gsl::make_span(out, kOutBufferSize));
+  }
+  return 0;
+}
+
+/*
+  Same as Sign(), except that k is derived from the private key and the message as in RFC 6979
+  (see SignEcdsaDeterministic()).
+*/
+extern "C" int SignDeterministic(
+    const gsl::byte private_key[kElementSize], const gsl::byte message[kElementSize],
+    gsl::byte out[kOutBufferSize]) {
+  try {
+    const auto sig = SignEcdsaDeterministic(
+        Deserialize(gsl::make_span(private_key, kElementSize)),
+        PrimeFieldElement::FromBigInt(Deserialize(gsl::make_span(message, kElementSize))));
+
+    Serialize(sig.first.ToStandardForm(), gsl::make_span(out, kElementSize));
+    Serialize(sig.second.ToStandardForm(), gsl::make_span(out + kElementSize, kElementSize));
+  } catch (const std::exception& e) {
+    return HandleError(e.what(), gsl::make_span(out, kOutBufferSize));
+  } catch (...) {
+    return HandleError("Unknown c++ exception.", gsl::make_span(out, kOutBufferSize));
+  }
+  return 0;
+}
+
+extern "C" int GetPublicKeyV2(
+    const gsl::byte private_key[kElementSize], gsl::byte out[kElementSize]) {
+  return CallWithErrorCode([&] {
+    const auto stark_key = GetStarkKey(Deserialize(gsl::make_span(private_key, kElementSize)));
+    Serialize(stark_key.ToStandardForm(), gsl::make_span(out, kElementSize));
+  });
+}
+
+extern "C" int VerifyV2(
+    const gsl::byte stark_key[kElementSize], const gsl::byte msg_hash[kElementSize],
+    const gsl::byte r_bytes[kElementSize], const gsl::byte w_bytes[kElementSize]) {
+  int res = CRYPTO_OK;
+  const int error = CallWithErrorCode([&] {
+    res = ToCryptoError(VerifyValues(
+        ReadValue(stark_key), ReadValue(msg_hash), ReadValue(r_bytes), ReadValue(w_bytes)));
+  });
+  return error != CRYPTO_OK ? error : res;
+}
+
+extern "C" int VerifyRSV2(
+    const gsl::byte stark_key[kElementSize], const gsl::byte msg_hash[kElementSize],
+    const gsl::byte r_bytes[kElementSize], const gsl::byte s_bytes[kElementSize]) {
+  int res = CRYPTO_OK;
+  const int error = CallWithErrorCode([&] {
+    res = VerifyRSValues(
+        ReadValue(stark_key), ReadValue(msg_hash), ReadValue(r_bytes), ReadValue(s_bytes));
+  });
+  return error != CRYPTO_OK ? error : res;
+}
+
+extern "C" int SignV2(
+    const gsl::byte private_key[kElementSize], const gsl::byte message[kElementSize],
+    const gsl::byte k[kElementSize], gsl::byte out[2 * kElementSize]) {
+  return CallWithErrorCode([&] {
+    const auto sig = SignEcdsa(
+        Deserialize(gsl::make_span(private_key, kElementSize)), ReadElement(message),
+        Deserialize(gsl::make_span(k, kElementSize)));
+    Serialize(sig.first.ToStandardForm(), gsl::make_span(out, kElementSize));
+    Serialize(sig.second.ToStandardForm(), gsl::make_span(out + kElementSize, kElementSize));
+  });
+}
+
+extern "C" int SignRSV2(
+    const gsl::byte private_key[kElementSize], const gsl::byte message[kElementSize],
+    const gsl::byte k[kElementSize], gsl::byte out[2 * kElementSize]) {
+  return CallWithErrorCode([&] {
+    const auto [r, s] = SignRSValues(
+        Deserialize(gsl::make_span(private_key, kElementSize)),
+        Deserialize(gsl::make_span(message, kElementSize)),
+        Deserialize(gsl::make_span(k, kElementSize)));
+    Serialize(r, gsl::make_span(out, kElementSize));
+    Serialize(s, gsl::make_span(out + kElementSize, kElementSize));
+  });
+}
+
+extern "C" int GetPublicKeyHex(const char* private_key, char* out) {
+  return CallWithErrorCode([&] {
+    WriteHex(GetStarkKey(ValueType::FromHex(private_key)).ToStandardForm(), out);
+  });
+}
+
+extern "C" int VerifyRSHex(
+    const char* stark_key, const char* msg_hash, const char* r_hex, const char* s_hex) {
+  int res = CRYPTO_OK;
+  const int error = CallWithErrorCode([&] {
+    res = VerifyRSValues(
+        ValueType::FromHex(stark_key), ValueType::FromHex(msg_hash), ValueType::FromHex(r_hex),
+        ValueType::FromHex(s_hex));
+  });
+  return error != CRYPTO_OK ? error : res;
+}
+
+extern "C" int SignRSHex(
+    const char* private_key, const char* message, const char* k, char* r_out, char* s_out) {
+  return CallWithErrorCode([&] {
+    const auto [r, s] = SignRSValues(
+        ValueType::FromHex(private_key), ValueType::FromHex(message), ValueType::FromHex(k));
+    WriteHex(r, r_out);
+    WriteHex(s, s_out);
+  });
+}
+
 }  // namespace starkware
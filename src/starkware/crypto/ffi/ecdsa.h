@@ -1,10 +1,52 @@
 #ifndef STARKWARE_CRYPTO_FFI_ECDSA_H_
 #define STARKWARE_CRYPTO_FFI_ECDSA_H_
 
+#include <stddef.h>
+
+#include "error.h"
+
 int GetPublicKey(const char* private_key, char* out);
 
 int Verify(const char* stark_key, const char* msg_hash, const char* r_bytes, const char* w_bytes);
 
+int VerifyRS(const char* stark_key, const char* msg_hash, const char* r_bytes, const char* s_bytes);
+
+int VerifyParallel(const char* requests, size_t n_requests, size_t n_threads, char* results);
+
 int Sign(const char* private_key, const char* message, const char* k, char* out);
 
+int SignRS(const char* private_key, const char* message, const char* k, char* out);
+
+int SignDeterministic(const char* private_key, const char* message, char* out);
+
+/*
+  V2 exports: same as the exports above, except that the outputs are exactly sized (one element,
+  or two for a signature), and the return value is a CryptoError (see error.h).
+*/
+
+int GetPublicKeyV2(const char* private_key, char* out);
+
+int VerifyV2(const char* stark_key, const char* msg_hash, const char* r_bytes, const char* w_bytes);
+
+int VerifyRSV2(
+    const char* stark_key, const char* msg_hash, const char* r_bytes, const char* s_bytes);
+
+int SignV2(const char* private_key, const char* message, const char* k, char* out);
+
+int SignRSV2(const char* private_key, const char* message, const char* k, char* out);
+
+/*
+  Hex exports: same as the V2 exports above, except that the inputs are null-terminated hex
+  strings, with or without a "0x" prefix, and every output is written as a hex string of
+  CRYPTO_HEX_STRING_SIZE characters. Unlike HashHex(), the values are not reduced, so that a
+  message hash or a signature that is out of range is rejected.
+*/
+
+int GetPublicKeyHex(const char* private_key, char* out);
+
+int VerifyRSHex(const char* stark_key, const char* msg_hash, const char* r_hex, const char* s_hex);
+
+int SignRSHex(
+    const char* private_key, const char* message, const char* k, char* r_out, char* s_out);
+
 #endif  // STARKWARE_CRYPTO_FFI_ECDSA_H_
@@ -0,0 +1,28 @@
+#ifndef STARKWARE_CRYPTO_FFI_ERROR_H_
+#define STARKWARE_CRYPTO_FFI_ERROR_H_
+
+/*
+  The return values of the V2 exports (e.g., HashV2()). On an error, the message is available from
+  GetLastErrorMessage() on the same thread, until the next error on that thread.
+*/
+enum CryptoError {
+  CRYPTO_OK = 0,
+  // The input was rejected (e.g., a zero message hash).
+  CRYPTO_ERROR_INVALID_INPUT = 1,
+  // The signature does not match the input (VerifyV2() and VerifyRSV2() only).
+  CRYPTO_ERROR_INVALID_SIGNATURE = 2,
+  CRYPTO_ERROR_INTERNAL = 3,
+};
+
+/*
+  The size of the outputs of the hex exports (e.g., HashHex()): "0x", followed by 64 lower case hex
+  digits and a null terminator.
+*/
+enum { CRYPTO_HEX_STRING_SIZE = 67 };
+
+/*
+  Returns the message of the last error on the calling thread, or an empty string.
+*/
+const char* GetLastErrorMessage(void);
+
+#endif  // STARKWARE_CRYPTO_FFI_ERROR_H_
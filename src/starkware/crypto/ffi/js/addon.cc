@@ -0,0 +1,405 @@
+/*
+  A native N-API addon for Node.js, built from the C++ sources directly (without the C exports and
+  ffi-napi).
+
+  Exports pedersen, verify, sign and getPublicKey, with the arguments and the results of the
+  functions of crypto.js (BigInts, signatures as (r, s)). Every function also has:
+    * A batch variant (e.g., pedersenBatch), which takes an array per argument and returns an array
+      of results, and uses the batched and parallel C++ paths.
+    * An async variant of the single and batch functions (e.g., pedersenAsync,
+      pedersenBatchAsync), which returns a Promise and runs the computation on the libuv thread
+      pool, so that the event loop is not blocked.
+  The inverse s <-> w is computed natively.
+*/
+
+#define NAPI_VERSION 6
+#include <node_api.h>
+
+#include <exception>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "starkware/algebra/prime_field_element.h"
+#include "starkware/crypto/ecdsa.h"
+#include "starkware/crypto/elliptic_curve_constants.h"
+#include "starkware/crypto/pedersen_hash.h"
+#include "starkware/utils/error_handling.h"
+
+namespace starkware {
+
+namespace {
+
+using ValueType = PrimeFieldElement::ValueType;
+
+void NapiCall(napi_status status) { ASSERT(status == napi_ok, "N-API call failed."); }
+
+ValueType ToValue(napi_env env, napi_value value) {
+  napi_valuetype type;
+  NapiCall(napi_typeof(env, value, &type));
+  ASSERT(type == napi_bigint, "Expected a BigInt.");
+  ValueType res = ValueType::Zero();
+  int sign_bit = 0;
+  size_t word_count = ValueType::LimbCount();
+  // Fails if more than LimbCount() words are needed.
+  ASSERT(
+      napi_get_value_bigint_words(env, value, &sign_bit, &word_count, &res[0]) == napi_ok &&
+          word_count <= ValueType::LimbCount(),
+      "Value is too big.");
+  ASSERT(sign_bit == 0, "Value must not be negative.");
+  return res;
+}
+
+napi_value FromValue(napi_env env, const ValueType& value) {
+  napi_value res;
+  NapiCall(napi_create_bigint_words(env, 0, ValueType::LimbCount(), &value[0], &res));
+  return res;
+}
+
+napi_value FromBool(napi_env env, bool value) {
+  napi_value res;
+  NapiCall(napi_get_boolean(env, value, &res));
+  return res;
+}
+
+/*
+  Reads the argument of an item. If kBatch, the argument is an array of n_items values, and
+  otherwise it is a single value.
+*/
+template <bool kBatch>
+std::vector<ValueType> ToValues(napi_env env, napi_value arg) {
+  if (!kBatch) {
+    return {ToValue(env, arg)};
+  }
+  bool is_array;
+  NapiCall(napi_is_array(env, arg, &is_array));
+  ASSERT(is_array, "Expected an array.");
+  uint32_t length;
+  NapiCall(napi_get_array_length(env, arg, &length));
+  std::vector<ValueType> values;
+  values.reserve(length);
+  for (uint32_t i = 0; i < length; ++i) {
+    napi_value element;
+    NapiCall(napi_get_element(env, arg, i, &element));
+    values.push_back(ToValue(env, element));
+  }
+  return values;
+}
+
+/*
+  Returns an array of results if kBatch, and the single result otherwise.
+*/
+template <bool kBatch, typename T, typename Func>
+napi_value FromResults(napi_env env, const std::vector<T>& results, const Func& from_result) {
+  if (!kBatch) {
+    return from_result(env, results.at(0));
+  }
+  napi_value array;
+  NapiCall(napi_create_array_with_length(env, results.size(), &array));
+  for (size_t i = 0; i < results.size(); ++i) {
+    NapiCall(napi_set_element(env, array, i, from_result(env, results[i])));
+  }
+  return array;
+}
+
+template <typename T>
+std::vector<PrimeFieldElement> ToFieldElements(const std::vector<T>& values) {
+  std::vector<PrimeFieldElement> elements;
+  elements.reserve(values.size());
+  for (const auto& value : values) {
+    elements.push_back(PrimeFieldElement::FromBigInt(value));
+  }
+  return elements;
+}
+
+/*
+  Returns s^-1 modulo the order of the curve. Converts between the s of a signature and its w.
+*/
+ValueType InvertOnCurve(const ValueType& s) {
+  return s.InvModPrimeVariableTime(GetEcConstants().k_order);
+}
+
+/*
+  The operations below are constructed from the arguments on the main thread (Parse()), run on any
+  thread (Run()), and convert their results to JavaScript values on the main thread (ToJs()).
+*/
+
+template <bool kBatch>
+class PedersenOp {
+ public:
+  static constexpr size_t kNumArgs = 2;
+
+  void Parse(napi_env env, const napi_value* args) {
+    xs_ = ToFieldElements(ToValues<kBatch>(env, args[0]));
+    ys_ = ToFieldElements(ToValues<kBatch>(env, args[1]));
+  }
+
+  void Run() {
+    hashes_.assign(xs_.size(), PrimeFieldElement::Zero());
+    PedersenHashBatch(xs_, ys_, hashes_);
+  }
+
+  napi_value ToJs(napi_env env) const {
+    return FromResults<kBatch>(env, hashes_, [](napi_env env, const PrimeFieldElement& hash) {
+      return FromValue(env, hash.ToStandardForm());
+    });
+  }
+
+ private:
+  std::vector<PrimeFieldElement> xs_;
+  std::vector<PrimeFieldElement> ys_;
+  std::vector<PrimeFieldElement> hashes_;
+};
+
+template <bool kBatch>
+class VerifyOp {
+ public:
+  static constexpr size_t kNumArgs = 4;
+
+  void Parse(napi_env env, const napi_value* args) {
+    stark_keys_ = ToValues<kBatch>(env, args[0]);
+    msg_hashes_ = ToValues<kBatch>(env, args[1]);
+    rs_ = ToValues<kBatch>(env, args[2]);
+    ss_ = ToValues<kBatch>(env, args[3]);
+    const size_t n_items = stark_keys_.size();
+    ASSERT(
+        msg_hashes_.size() == n_items && rs_.size() == n_items && ss_.size() == n_items,
+        "Number of stark keys, message hashes and signatures mismatch.");
+  }
+
+  void Run() {
+    std::vector<VerifyRequest> requests;
+    requests.reserve(stark_keys_.size());
+    const auto& prime = PrimeFieldElement::kModulus;
+    const PrimeFieldElement zero = PrimeFieldElement::Zero();
+    for (size_t i = 0; i < stark_keys_.size(); ++i) {
+      const ValueType& s = ss_[i];
+      if (stark_keys_[i] >= prime || msg_hashes_[i] >= prime || rs_[i] >= prime ||
+          s == ValueType::Zero() || s >= GetEcConstants().k_order) {
+        // A value that is out of range fails the verification, instead of throwing in
+        // FromBigInt() or InvertOnCurve(). A request with w = 0 is rejected by
+        // VerifyEcdsaParallel().
+        requests.push_back({zero, zero, {zero, zero}});
+        continue;
+      }
+      requests.push_back(
+          {PrimeFieldElement::FromBigInt(stark_keys_[i]),
+           PrimeFieldElement::FromBigInt(msg_hashes_[i]),
+           {PrimeFieldElement::FromBigInt(rs_[i]),
+            PrimeFieldElement::FromBigInt(InvertOnCurve(s))}});
+    }
+    results_.assign(requests.size(), 0);
+    VerifyEcdsaParallel(requests, results_);
+  }
+
+  napi_value ToJs(napi_env env) const {
+    return FromResults<kBatch>(
+        env, results_, [](napi_env env, uint8_t result) { return FromBool(env, result != 0); });
+  }
+
+ private:
+  std::vector<ValueType> stark_keys_;
+  std::vector<ValueType> msg_hashes_;
+  std::vector<ValueType> rs_;
+  std::vector<ValueType> ss_;
+  std::vector<uint8_t> results_;
+};
+
+template <bool kBatch>
+class SignOp {
+ public:
+  static constexpr size_t kNumArgs = 3;
+
+  void Parse(napi_env env, const napi_value* args) {
+    private_keys_ = ToValues<kBatch>(env, args[0]);
+    msg_hashes_ = ToFieldElements(ToValues<kBatch>(env, args[1]));
+    ks_ = ToValues<kBatch>(env, args[2]);
+  }
+
+  void Run() {
+    const std::vector<Signature> sigs = SignEcdsaBatch(private_keys_, msg_hashes_, ks_);
+    rs_and_ss_.clear();
+    rs_and_ss_.reserve(sigs.size());
+    for (const Signature& sig : sigs) {
+      rs_and_ss_.emplace_back(
+          sig.first.ToStandardForm(), InvertOnCurve(sig.second.ToStandardForm()));
+    }
+  }
+
+  napi_value ToJs(napi_env env) const {
+    return FromResults<kBatch>(
+        env, rs_and_ss_, [](napi_env env, const std::pair<ValueType, ValueType>& r_and_s) {
+          napi_value res;
+          NapiCall(napi_create_object(env, &res));
+          NapiCall(napi_set_named_property(env, res, "r", FromValue(env, r_and_s.first)));
+          NapiCall(napi_set_named_property(env, res, "s", FromValue(env, r_and_s.second)));
+          return res;
+        });
+  }
+
+ private:
+  std::vector<ValueType> private_keys_;
+  std::vector<PrimeFieldElement> msg_hashes_;
+  std::vector<ValueType> ks_;
+  std::vector<std::pair<ValueType, ValueType>> rs_and_ss_;
+};
+
+template <bool kBatch>
+class GetPublicKeyOp {
+ public:
+  static constexpr size_t kNumArgs = 1;
+
+  void Parse(napi_env env, const napi_value* args) {
+    private_keys_ = ToValues<kBatch>(env, args[0]);
+  }
+
+  void Run() {
+    if (kBatch) {
+      public_keys_ = GetPublicKeysBatch(private_keys_);
+    } else {
+      public_keys_ = {{GetStarkKey(private_keys_.at(0)), PrimeFieldElement::Zero()}};
+    }
+  }
+
+  napi_value ToJs(napi_env env) const {
+    return FromResults<kBatch>(
+        env, public_keys_, [](napi_env env, const EcPoint<PrimeFieldElement>& public_key) {
+          return FromValue(env, public_key.x.ToStandardForm());
+        });
+  }
+
+ private:
+  std::vector<ValueType> private_keys_;
+  std::vector<EcPoint<PrimeFieldElement>> public_keys_;
+};
+
+template <typename Op>
+Op ParseArgs(napi_env env, napi_callback_info info) {
+  size_t argc = Op::kNumArgs;
+  napi_value args[Op::kNumArgs];
+  NapiCall(napi_get_cb_info(env, info, &argc, args, nullptr, nullptr));
+  ASSERT(argc == Op::kNumArgs, "Wrong number of arguments.");
+  Op op;
+  op.Parse(env, args);
+  return op;
+}
+
+napi_value CreateError(napi_env env, const char* msg) {
+  napi_value msg_value, error;
+  NapiCall(napi_create_string_utf8(env, msg, NAPI_AUTO_LENGTH, &msg_value));
+  NapiCall(napi_create_error(env, nullptr, msg_value, &error));
+  return error;
+}
+
+/*
+  Runs the operation on the main thread. Errors are thrown as JavaScript exceptions.
+*/
+template <typename Op>
+napi_value CallSync(napi_env env, napi_callback_info info) {
+  try {
+    Op op = ParseArgs<Op>(env, info);
+    op.Run();
+    return op.ToJs(env);
+  } catch (const std::exception& e) {
+    napi_throw_error(env, nullptr, e.what());
+  }
+  return nullptr;
+}
+
+template <typename Op>
+struct AsyncCall {
+  Op op;
+  napi_deferred deferred = nullptr;
+  napi_async_work work = nullptr;
+  std::string error;
+};
+
+/*
+  Runs the operation on the libuv thread pool, and returns a Promise of its result. Errors in the
+  arguments are thrown synchronously, and errors in the computation reject the Promise.
+*/
+template <typename Op>
+napi_value CallAsync(napi_env env, napi_callback_info info) {
+  auto* call = new AsyncCall<Op>();
+  try {
+    call->op = ParseArgs<Op>(env, info);
+
+    napi_value resource_name;
+    NapiCall(napi_create_string_utf8(env, "StarkwareCrypto", NAPI_AUTO_LENGTH, &resource_name));
+    const auto execute = [](napi_env /*env*/, void* data) {
+      auto* call = static_cast<AsyncCall<Op>*>(data);
+      try {
+        call->op.Run();
+      } catch (const std::exception& e) {
+        call->error = e.what();
+      }
+    };
+    const auto complete = [](napi_env env, napi_status /*status*/, void* data) {
+      auto* call = static_cast<AsyncCall<Op>*>(data);
+      try {
+        if (call->error.empty()) {
+          NapiCall(napi_resolve_deferred(env, call->deferred, call->op.ToJs(env)));
+        } else {
+          NapiCall(
+              napi_reject_deferred(env, call->deferred, CreateError(env, call->error.c_str())));
+        }
+      } catch (const std::exception& e) {
+        napi_reject_deferred(env, call->deferred, CreateError(env, e.what()));
+      }
+      napi_delete_async_work(env, call->work);
+      delete call;
+    };
+    NapiCall(
+        napi_create_async_work(env, nullptr, resource_name, execute, complete, call, &call->work));
+
+    napi_value promise;
+    NapiCall(napi_create_promise(env, &call->deferred, &promise));
+    NapiCall(napi_queue_async_work(env, call->work));
+    return promise;
+  } catch (const std::exception& e) {
+    if (call->work != nullptr) {
+      napi_delete_async_work(env, call->work);
+    }
+    // A promise is only created right before the work is queued, so nothing else is pending.
+    delete call;
+    napi_throw_error(env, nullptr, e.what());
+  }
+  return nullptr;
+}
+
+template <template <bool> class Op>
+void ExportOp(napi_env env, napi_value exports, const std::string& name) {
+  const std::string batch_name = name + "Batch";
+  const std::string async_name = name + "Async";
+  const std::string batch_async_name = name + "BatchAsync";
+  const napi_property_descriptor properties[] = {
+      {name.c_str(), nullptr, CallSync<Op<false>>, nullptr, nullptr, nullptr, napi_enumerable,
+       nullptr},
+      {batch_name.c_str(), nullptr, CallSync<Op<true>>, nullptr, nullptr, nullptr, napi_enumerable,
+       nullptr},
+      {async_name.c_str(), nullptr, CallAsync<Op<false>>, nullptr, nullptr, nullptr,
+       napi_enumerable, nullptr},
+      {batch_async_name.c_str(), nullptr, CallAsync<Op<true>>, nullptr, nullptr, nullptr,
+       napi_enumerable, nullptr},
+  };
+  NapiCall(napi_define_properties(env, exports, std::size(properties), properties));
+}
+
+napi_value Init(napi_env env, napi_value exports) {
+  try {
+    ExportOp<PedersenOp>(env, exports, "pedersen");
+    ExportOp<VerifyOp>(env, exports, "verify");
+    ExportOp<SignOp>(env, exports, "sign");
+    ExportOp<GetPublicKeyOp>(env, exports, "getPublicKey");
+  } catch (const std::exception& e) {
+    napi_throw_error(env, nullptr, e.what());
+  }
+  return exports;
+}
+
+}  // namespace
+
+}  // namespace starkware
+
+NAPI_MODULE(NODE_GYP_MODULE_NAME, starkware::Init)
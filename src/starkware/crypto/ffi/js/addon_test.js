@@ -0,0 +1,81 @@
+// Tests the N-API addon (see addon.cc). Usage: node addon_test.js <path to crypto_addon.node>.
+// Uses only the built-in modules of Node.js, so that it runs without npm.
+
+const assert = require('assert');
+const path = require('path');
+
+const addon = require(path.resolve(process.argv[2]));
+const testData = require('./test/signature_test_data.json');
+
+const privateKey = BigInt('0x1');
+const starkKey = BigInt('0x1ef15c18599971b7beced415a40f0c7deacfd9b0d1819e03d723d8bc943cfca');
+const message = BigInt('0x2');
+const k = BigInt('0x3');
+const r = BigInt('0x411494b501a98abd8262b0da1351e17899a0c4ef23dd2f96fec5ba847310b20');
+const s = BigInt('0x405c3191ab3883ef2b763af35bc5f5d15b3b4e99461d70e84c654a351a7c81b');
+
+async function main() {
+    // Single items.
+    const hashTests = [
+        testData.hash_test.pedersen_hash_data_1, testData.hash_test.pedersen_hash_data_2
+    ];
+    for (const hashTest of hashTests) {
+        assert.strictEqual(
+            addon.pedersen(BigInt(hashTest.input_1), BigInt(hashTest.input_2)),
+            BigInt(hashTest.output));
+    }
+    assert.strictEqual(addon.getPublicKey(privateKey), starkKey);
+    assert.deepStrictEqual(addon.sign(privateKey, message, k), { r, s });
+    assert.strictEqual(addon.verify(starkKey, message, r, s), true);
+    assert.strictEqual(addon.verify(starkKey, message + 1n, r, s), false);
+    const order = BigInt('0x800000000000010ffffffffffffffffb781126dcae7b2321e66a241adc64d2f');
+    assert.strictEqual(addon.verify(starkKey, message, r, 0n), false);
+    assert.strictEqual(addon.verify(starkKey, message, r, order), false);
+    const prime = BigInt('0x800000000000011000000000000000000000000000000000000000000000001');
+    assert.strictEqual(addon.verify(prime, message, r, s), false);
+    assert.strictEqual(addon.verify(starkKey, prime, r, s), false);
+    assert.strictEqual(addon.verify(starkKey, message, prime + r, s), false);
+
+    // Batches.
+    assert.deepStrictEqual(
+        addon.pedersenBatch(
+            hashTests.map(t => BigInt(t.input_1)), hashTests.map(t => BigInt(t.input_2))),
+        hashTests.map(t => BigInt(t.output)));
+    const privateKeys = Array.from({ length: 100 }, (_, i) => BigInt(i + 1));
+    const messages = privateKeys.map(x => x * 7n);
+    const ks = privateKeys.map(x => x + 1000n);
+    const starkKeys = addon.getPublicKeyBatch(privateKeys);
+    assert.deepStrictEqual(starkKeys, privateKeys.map(x => addon.getPublicKey(x)));
+    const sigs = addon.signBatch(privateKeys, messages, ks);
+    assert.deepStrictEqual(sigs[0], addon.sign(privateKeys[0], messages[0], ks[0]));
+    const rs = sigs.map(sig => sig.r);
+    const ss = sigs.map(sig => sig.s);
+    ss[3] += 1n;
+    ss[5] = 0n;
+    rs[7] += prime;
+    const expectedResults = privateKeys.map((_, i) => i != 3 && i != 5 && i != 7);
+    assert.deepStrictEqual(addon.verifyBatch(starkKeys, messages, rs, ss), expectedResults);
+
+    // Async.
+    assert.strictEqual(await addon.getPublicKeyAsync(privateKey), starkKey);
+    assert.deepStrictEqual(await addon.signAsync(privateKey, message, k), { r, s });
+    assert.deepStrictEqual(
+        await addon.verifyBatchAsync(starkKeys, messages, rs, ss), expectedResults);
+    assert.deepStrictEqual(await addon.getPublicKeyBatchAsync(privateKeys), starkKeys);
+    assert.deepStrictEqual(
+        await Promise.all(hashTests.map(
+            t => addon.pedersenAsync(BigInt(t.input_1), BigInt(t.input_2)))),
+        hashTests.map(t => BigInt(t.output)));
+
+    // Errors.
+    assert.throws(() => addon.pedersen(1n), /Wrong number of arguments/);
+    assert.throws(() => addon.getPublicKey(-1n), /must not be negative/);
+    assert.throws(() => addon.getPublicKey(1n << 256n), /too big/);
+    assert.throws(() => addon.sign(privateKey, 0n, k), /Message cannot be zero/);
+    await assert.rejects(addon.signAsync(privateKey, 0n, k), /Message cannot be zero/);
+}
+
+main().then(() => console.log('All tests passed.'), e => {
+    console.error(e);
+    process.exit(1);
+});
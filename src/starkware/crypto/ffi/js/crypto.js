@@ -14,20 +14,28 @@
 // and limitations under the License.                                          //
 /////////////////////////////////////////////////////////////////////////////////
 
-const BN = require('bn.js');
-const BigIntBuffer = require('bigint-buffer');
 const { assert } = require('chai');
 const ffi = require('ffi-napi');
 
 // Native crypto bindings.
 const libcrypto = ffi.Library('./libcrypto_c_exports', {
-    'Hash': ['int', ['string', 'string', 'string']],
-    'Verify': ['bool', ['string', 'string', 'string', 'string']],
-    'Sign': ['int', ['string', 'string', 'string', 'string']],
-    'GetPublicKey': ['int', ['string', 'string']],
+    'HashHex': ['int', ['string', 'string', 'char *']],
+    'VerifyRSHex': ['int', ['string', 'string', 'string', 'string']],
+    'SignRSHex': ['int', ['string', 'string', 'string', 'char *', 'char *']],
+    'GetPublicKeyHex': ['int', ['string', 'char *']],
+    'GetLastErrorMessage': ['string', []],
 });
 
-const curveOrder = new BN('800000000000010ffffffffffffffffb781126dcae7b2321e66a241adc64d2f', 16)
+// The size of the hex outputs of the native bindings: "0x", 64 hex digits and a null terminator.
+const HEX_STRING_SIZE = 67;
+
+function toHex(x) {
+    return '0x' + x.toString(16);
+}
+
+function fromHex(buf) {
+    return BigInt(buf.toString('ascii', 0, HEX_STRING_SIZE - 1));
+}
 
 /*
  Computes the StarkWare version of the Pedersen hash of x and y.
@@ -35,12 +43,10 @@ const curveOrder = new BN('800000000000010ffffffffffffffffb781126dcae7b2321e66a2
  https://docs.starkware.co/starkex-docs/crypto/pedersen-hash-function
 */
 function pedersen(x, y) {
-    const x_buf = BigIntBuffer.toBufferLE(x, 32);
-    const y_buf = BigIntBuffer.toBufferLE(y, 32);
-    const res_buf = Buffer.alloc(1024);
-    const res = libcrypto.Hash(x_buf, y_buf, res_buf);
-    assert(res == 0, 'Error: ' + res_buf.toString('utf-8'));
-    return BigIntBuffer.toBigIntLE(res_buf);
+    const res_buf = Buffer.alloc(HEX_STRING_SIZE);
+    const res = libcrypto.HashHex(toHex(x), toHex(y), res_buf);
+    assert(res == 0, 'Error: ' + libcrypto.GetLastErrorMessage());
+    return fromHex(res_buf);
 }
 
 /*
@@ -49,13 +55,7 @@ function pedersen(x, y) {
  NOTE: This function assumes that the public_key is on the curve.
 */
 function verify(stark_key, message_hash, r, s) {
-    const stark_key_buf = BigIntBuffer.toBufferLE(stark_key, 32);
-    const message_hash_buf = BigIntBuffer.toBufferLE(message_hash, 32);
-    const r_buf = BigIntBuffer.toBufferLE(r, 32);
-    const bnS = new BN(s.toString(16), 16);
-    const w = BigInt('0x' + bnS.invm(curveOrder).toString(16), 16)
-    const s_buf = BigIntBuffer.toBufferLE(w, 32);
-    return libcrypto.Verify(stark_key_buf, message_hash_buf, r_buf, s_buf);
+    return libcrypto.VerifyRSHex(toHex(stark_key), toHex(message_hash), toHex(r), toHex(s)) == 0;
 }
 
 /*
@@ -65,17 +65,11 @@ function verify(stark_key, message_hash, r, s) {
  See: https://tools.ietf.org/html/rfc6979.
 */
 function sign(private_key, message, k) {
-    const private_key_buf = BigIntBuffer.toBufferLE(private_key, 32);
-    const message_buf = BigIntBuffer.toBufferLE(message, 32);
-    const k_buf = BigIntBuffer.toBufferLE(k, 32);
-    const res_buf = Buffer.alloc(1024);
-    const res = libcrypto.Sign(private_key_buf, message_buf, k_buf, res_buf);
-    assert(res == 0, 'Error: ' + res_buf.toString('utf-8'));
-    const r = BigIntBuffer.toBigIntLE(res_buf.slice(0, 32));
-    const w = BigIntBuffer.toBigIntLE(res_buf.slice(32, 64));
-    const bnW = new BN(w.toString(16), 16)
-    const s = BigInt('0x' + bnW.invm(curveOrder).toString(16), 16)
-    return {r: r, s: s};
+    const r_buf = Buffer.alloc(HEX_STRING_SIZE);
+    const s_buf = Buffer.alloc(HEX_STRING_SIZE);
+    const res = libcrypto.SignRSHex(toHex(private_key), toHex(message), toHex(k), r_buf, s_buf);
+    assert(res == 0, 'Error: ' + libcrypto.GetLastErrorMessage());
+    return {r: fromHex(r_buf), s: fromHex(s_buf)};
 }
 
 /*
@@ -84,11 +78,10 @@ function sign(private_key, message, k) {
  and used in StarkEx to identify the user.
 */
 function getPublicKey(private_key) {
-    const private_key_buf = BigIntBuffer.toBufferLE(private_key, 32);
-    const res_buf = Buffer.alloc(1024);
-    const res = libcrypto.GetPublicKey(private_key_buf, res_buf);
-    assert(res == 0, 'Error: ' + res_buf.toString('utf-8'));
-    return BigIntBuffer.toBigIntLE(res_buf);
+    const res_buf = Buffer.alloc(HEX_STRING_SIZE);
+    const res = libcrypto.GetPublicKeyHex(toHex(private_key), res_buf);
+    assert(res == 0, 'Error: ' + libcrypto.GetLastErrorMessage());
+    return fromHex(res_buf);
 }
 
 module.exports = {
@@ -36,4 +36,26 @@ extern "C" int Hash(
   return 0;
 }
 
+/*
+  Same as Hash(), except that out is exactly one element, and errors are reported as in error.h.
+*/
+extern "C" int HashV2(
+    const gsl::byte in1[kElementSize], const gsl::byte in2[kElementSize],
+    gsl::byte out[kElementSize]) {
+  return CallWithErrorCode([&] {
+    const auto hash = PedersenHash(
+        PrimeFieldElement::FromBigInt(Deserialize(gsl::make_span(in1, kElementSize))),
+        PrimeFieldElement::FromBigInt(Deserialize(gsl::make_span(in2, kElementSize))));
+    Serialize(hash.ToStandardForm(), gsl::make_span(out, kElementSize));
+  });
+}
+
+extern "C" int HashHex(const char* in1, const char* in2, char* out) {
+  return CallWithErrorCode([&] {
+    const auto hash =
+        PedersenHash(PrimeFieldElement::FromHex(in1), PrimeFieldElement::FromHex(in2));
+    WriteHex(hash.ToStandardForm(), out);
+  });
+}
+
 }  // namespace starkware
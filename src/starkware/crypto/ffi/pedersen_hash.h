@@ -1,6 +1,17 @@
 #ifndef STARKWARE_CRYPTO_FFI_PEDERSEN_HASH_H_
 #define STARKWARE_CRYPTO_FFI_PEDERSEN_HASH_H_
 
+#include "error.h"
+
 int Hash(const char* in1, const char* in2, char* out);
 
+int HashV2(const char* in1, const char* in2, char* out);
+
+/*
+  Same as HashV2(), except that in1 and in2 are null-terminated hex strings, with or without a "0x"
+  prefix, whose values are reduced modulo the field's prime, and the hash is written to out as a
+  hex string of CRYPTO_HEX_STRING_SIZE characters.
+*/
+int HashHex(const char* in1, const char* in2, char* out);
+
 #endif  // STARKWARE_CRYPTO_FFI_PEDERSEN_HASH_H_
@@ -0,0 +1,487 @@
+/*
+  A CPython extension module, crypto_ext, built from the C++ sources directly.
+
+  Single-item functions take and return Python ints, with signatures as (r, s), as in the Python
+  signature module:
+    hash(x, y), verify(stark_key, msg_hash, r, s), sign(private_key, msg_hash, k),
+    get_public_key(private_key).
+
+  Batch functions take objects that support the buffer protocol (bytes, bytearray, memoryview,
+  NumPy uint8[n, 32] arrays, ...), each holding n contiguous elements of 32 bytes in little-endian,
+  and return bytes:
+    hash_batch(xs, ys) -> n hashes.
+    verify_batch(stark_keys, msg_hashes, rs, ss) -> n bytes: 1 for a valid signature, 0 otherwise.
+    sign_batch(private_keys, msg_hashes, ks) -> n signatures of 64 bytes: r followed by s.
+    get_public_key_batch(private_keys) -> n stark keys.
+  The batch functions take an optional n_threads argument (the default is the number of hardware
+  threads), and use the batched and parallel C++ paths.
+
+  All the functions release the GIL during the computation. Invalid inputs raise ValueError.
+*/
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#include <array>
+#include <exception>
+#include <initializer_list>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "third_party/gsl/gsl-lite.hpp"
+
+#include "starkware/algebra/prime_field_element.h"
+#include "starkware/crypto/ecdsa.h"
+#include "starkware/crypto/elliptic_curve_constants.h"
+#include "starkware/crypto/ffi/utils.h"
+#include "starkware/crypto/pedersen_hash.h"
+#include "starkware/utils/error_handling.h"
+#include "starkware/utils/parallel.h"
+
+namespace starkware {
+
+namespace {
+
+using ValueType = PrimeFieldElement::ValueType;
+
+constexpr size_t kElementSize = sizeof(ValueType);
+
+// The minimal number of items per thread, as in ffi/batch.cc.
+constexpr size_t kMinHashesPerThread = 256;
+constexpr size_t kMinSignaturesPerThread = 16;
+
+/*
+  A buffer of elements, acquired from a Python object with the buffer protocol.
+*/
+class ElementBuffer {
+ public:
+  ElementBuffer() = default;
+  ~ElementBuffer() {
+    if (acquired_) {
+      PyBuffer_Release(&view_);
+    }
+  }
+  ElementBuffer(const ElementBuffer&) = delete;
+  ElementBuffer& operator=(const ElementBuffer&) = delete;
+  ElementBuffer(ElementBuffer&&) = delete;
+  ElementBuffer& operator=(ElementBuffer&&) = delete;
+
+  /*
+    Returns false and sets a Python exception if obj is not a C-contiguous buffer of whole
+    elements.
+  */
+  bool Acquire(PyObject* obj) {
+    if (PyObject_GetBuffer(obj, &view_, PyBUF_C_CONTIGUOUS) != 0) {
+      return false;
+    }
+    acquired_ = true;
+    if (view_.len % kElementSize != 0) {
+      PyErr_SetString(PyExc_ValueError, "Buffer size must be a multiple of 32 bytes.");
+      return false;
+    }
+    return true;
+  }
+
+  size_t Size() const { return view_.len / kElementSize; }
+
+  ValueType Value(size_t index) const {
+    return Deserialize(gsl::make_span(
+        static_cast<const gsl::byte*>(view_.buf) + index * kElementSize, kElementSize));
+  }
+
+  PrimeFieldElement Element(size_t index) const {
+    return PrimeFieldElement::FromBigInt(Value(index));
+  }
+
+ private:
+  Py_buffer view_{};
+  bool acquired_ = false;
+};
+
+/*
+  Acquires all the given objects into buffers, and checks that they hold the same number of
+  elements.
+*/
+bool AcquireAll(
+    std::initializer_list<std::pair<PyObject*, ElementBuffer*>> objects, size_t* n_elements) {
+  for (const auto& [obj, buffer] : objects) {
+    if (!buffer->Acquire(obj)) {
+      return false;
+    }
+  }
+  *n_elements = objects.begin()->second->Size();
+  for (const auto& [obj, buffer] : objects) {
+    if (buffer->Size() != *n_elements) {
+      PyErr_SetString(PyExc_ValueError, "Number of elements in the buffers mismatch.");
+      return false;
+    }
+  }
+  return true;
+}
+
+/*
+  Returns a new bytes object of the given size, whose contents are written by the caller.
+*/
+PyObject* NewBytes(size_t size, gsl::byte** data) {
+  PyObject* res = PyBytes_FromStringAndSize(nullptr, size);
+  if (res != nullptr) {
+    *data = reinterpret_cast<gsl::byte*>(PyBytes_AS_STRING(res));
+  }
+  return res;
+}
+
+void WriteValue(const ValueType& value, gsl::byte* data, size_t index) {
+  Serialize(value, gsl::make_span(data + index * kElementSize, kElementSize));
+}
+
+bool ToValue(PyObject* obj, ValueType* value) {
+  PyObject* bytes = PyObject_CallMethod(obj, "to_bytes", "ns", Py_ssize_t{kElementSize}, "little");
+  if (bytes == nullptr) {
+    return false;
+  }
+  *value = Deserialize(gsl::make_span(
+      reinterpret_cast<const gsl::byte*>(PyBytes_AS_STRING(bytes)), kElementSize));
+  Py_DECREF(bytes);
+  return true;
+}
+
+PyObject* FromValue(const ValueType& value) {
+  std::array<gsl::byte, kElementSize> bytes{};
+  Serialize(value, bytes);
+  return PyObject_CallMethod(
+      reinterpret_cast<PyObject*>(&PyLong_Type), "from_bytes", "y#s",
+      reinterpret_cast<const char*>(bytes.data()), Py_ssize_t{kElementSize}, "little");
+}
+
+/*
+  Runs func with the GIL released. Converts exceptions to ValueError and returns false.
+*/
+template <typename Func>
+bool RunWithoutGil(const Func& func) {
+  std::string error;
+  Py_BEGIN_ALLOW_THREADS;
+  try {
+    func();
+  } catch (const std::exception& e) {
+    error = e.what();
+  }
+  Py_END_ALLOW_THREADS;
+  if (!error.empty()) {
+    PyErr_SetString(PyExc_ValueError, error.c_str());
+    return false;
+  }
+  return true;
+}
+
+size_t ToNumThreads(Py_ssize_t n_threads) {
+  return n_threads > 0 ? static_cast<size_t>(n_threads) : GetNumHardwareThreads();
+}
+
+/*
+  Returns w = s^-1 modulo the order of the curve, and vice versa.
+*/
+ValueType InvertOnCurve(const ValueType& s) {
+  const auto& curve_order = GetEcConstants().k_order;
+  ASSERT(s != ValueType::Zero() && s < curve_order, "s must be in the range [1, curve order).");
+  return s.InvModPrimeVariableTime(curve_order);
+}
+
+PyObject* Hash(PyObject* /*self*/, PyObject* args) {
+  PyObject *x_obj, *y_obj;
+  ValueType x, y;
+  if (!PyArg_ParseTuple(args, "OO", &x_obj, &y_obj) || !ToValue(x_obj, &x) ||
+      !ToValue(y_obj, &y)) {
+    return nullptr;
+  }
+  ValueType hash;
+  if (!RunWithoutGil([&] {
+        hash = PedersenHash(PrimeFieldElement::FromBigInt(x), PrimeFieldElement::FromBigInt(y))
+                   .ToStandardForm();
+      })) {
+    return nullptr;
+  }
+  return FromValue(hash);
+}
+
+PyObject* HashBatch(PyObject* /*self*/, PyObject* args, PyObject* kwargs) {
+  static const char* keywords[] = {"xs", "ys", "n_threads", nullptr};
+  PyObject *xs_obj, *ys_obj;
+  Py_ssize_t n_threads = 0;
+  if (!PyArg_ParseTupleAndKeywords(
+          args, kwargs, "OO|n", const_cast<char**>(keywords), &xs_obj, &ys_obj, &n_threads)) {
+    return nullptr;
+  }
+  ElementBuffer xs, ys;
+  size_t n;
+  if (!AcquireAll({{xs_obj, &xs}, {ys_obj, &ys}}, &n)) {
+    return nullptr;
+  }
+  gsl::byte* out;
+  PyObject* res = NewBytes(n * kElementSize, &out);
+  if (res == nullptr) {
+    return nullptr;
+  }
+  const bool success = RunWithoutGil([&] {
+    ParallelFor(
+        n, ToNumThreads(n_threads),
+        [&](size_t begin, size_t end) {
+          std::vector<PrimeFieldElement> chunk_xs, chunk_ys;
+          chunk_xs.reserve(end - begin);
+          chunk_ys.reserve(end - begin);
+          for (size_t i = begin; i < end; ++i) {
+            chunk_xs.push_back(xs.Element(i));
+            chunk_ys.push_back(ys.Element(i));
+          }
+          std::vector<PrimeFieldElement> hashes(end - begin, PrimeFieldElement::Zero());
+          PedersenHashBatch(chunk_xs, chunk_ys, hashes);
+          for (size_t i = begin; i < end; ++i) {
+            WriteValue(hashes[i - begin].ToStandardForm(), out, i);
+          }
+        },
+        kMinHashesPerThread);
+  });
+  if (!success) {
+    Py_DECREF(res);
+    return nullptr;
+  }
+  return res;
+}
+
+PyObject* Verify(PyObject* /*self*/, PyObject* args) {
+  PyObject *stark_key_obj, *msg_hash_obj, *r_obj, *s_obj;
+  ValueType stark_key, msg_hash, r, s;
+  if (!PyArg_ParseTuple(args, "OOOO", &stark_key_obj, &msg_hash_obj, &r_obj, &s_obj) ||
+      !ToValue(stark_key_obj, &stark_key) || !ToValue(msg_hash_obj, &msg_hash) ||
+      !ToValue(r_obj, &r) || !ToValue(s_obj, &s)) {
+    return nullptr;
+  }
+  bool result = false;
+  // Invalid inputs are rejected, as in Verify() of the C exports. Values that are out of range are
+  // rejected before they are converted, as the conversions throw on them.
+  const auto& prime = PrimeFieldElement::kModulus;
+  if (stark_key < prime && msg_hash < prime && r < prime && s != ValueType::Zero() &&
+      s < GetEcConstants().k_order && !RunWithoutGil([&] {
+        result = VerifyEcdsaPartialKeyChecked(
+                     PrimeFieldElement::FromBigInt(stark_key),
+                     PrimeFieldElement::FromBigInt(msg_hash),
+                     {PrimeFieldElement::FromBigInt(r),
+                      PrimeFieldElement::FromBigInt(InvertOnCurve(s))}) == VerifyStatus::kValid;
+      })) {
+    return nullptr;
+  }
+  return PyBool_FromLong(result);
+}
+
+PyObject* VerifyBatch(PyObject* /*self*/, PyObject* args, PyObject* kwargs) {
+  static const char* keywords[] = {"stark_keys", "msg_hashes", "rs", "ss", "n_threads", nullptr};
+  PyObject *stark_keys_obj, *msg_hashes_obj, *rs_obj, *ss_obj;
+  Py_ssize_t n_threads = 0;
+  if (!PyArg_ParseTupleAndKeywords(
+          args, kwargs, "OOOO|n", const_cast<char**>(keywords), &stark_keys_obj, &msg_hashes_obj,
+          &rs_obj, &ss_obj, &n_threads)) {
+    return nullptr;
+  }
+  ElementBuffer stark_keys, msg_hashes, rs, ss;
+  size_t n;
+  if (!AcquireAll(
+          {{stark_keys_obj, &stark_keys},
+           {msg_hashes_obj, &msg_hashes},
+           {rs_obj, &rs},
+           {ss_obj, &ss}},
+          &n)) {
+    return nullptr;
+  }
+  gsl::byte* out;
+  PyObject* res = NewBytes(n, &out);
+  if (res == nullptr) {
+    return nullptr;
+  }
+  const bool success = RunWithoutGil([&] {
+    const auto& prime = PrimeFieldElement::kModulus;
+    const PrimeFieldElement zero = PrimeFieldElement::Zero();
+    std::vector<VerifyRequest> requests;
+    requests.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+      const ValueType stark_key = stark_keys.Value(i);
+      const ValueType msg_hash = msg_hashes.Value(i);
+      const ValueType r = rs.Value(i);
+      const ValueType s = ss.Value(i);
+      if (stark_key >= prime || msg_hash >= prime || r >= prime || s == ValueType::Zero() ||
+          s >= GetEcConstants().k_order) {
+        // A value that is out of range fails the verification, instead of throwing in
+        // FromBigInt() or InvertOnCurve(). A request with w = 0 is rejected by
+        // VerifyEcdsaParallel().
+        requests.push_back({zero, zero, {zero, zero}});
+        continue;
+      }
+      requests.push_back(
+          {PrimeFieldElement::FromBigInt(stark_key), PrimeFieldElement::FromBigInt(msg_hash),
+           {PrimeFieldElement::FromBigInt(r), PrimeFieldElement::FromBigInt(InvertOnCurve(s))}});
+    }
+    VerifyEcdsaParallel(
+        requests, gsl::make_span(reinterpret_cast<uint8_t*>(out), n), ToNumThreads(n_threads));
+  });
+  if (!success) {
+    Py_DECREF(res);
+    return nullptr;
+  }
+  return res;
+}
+
+PyObject* Sign(PyObject* /*self*/, PyObject* args) {
+  PyObject *private_key_obj, *msg_hash_obj, *k_obj;
+  ValueType private_key, msg_hash, k;
+  if (!PyArg_ParseTuple(args, "OOO", &private_key_obj, &msg_hash_obj, &k_obj) ||
+      !ToValue(private_key_obj, &private_key) || !ToValue(msg_hash_obj, &msg_hash) ||
+      !ToValue(k_obj, &k)) {
+    return nullptr;
+  }
+  ValueType r, s;
+  if (!RunWithoutGil([&] {
+        const Signature sig = SignEcdsa(private_key, PrimeFieldElement::FromBigInt(msg_hash), k);
+        r = sig.first.ToStandardForm();
+        s = InvertOnCurve(sig.second.ToStandardForm());
+      })) {
+    return nullptr;
+  }
+  PyObject* r_obj = FromValue(r);
+  PyObject* s_obj = FromValue(s);
+  PyObject* res = (r_obj != nullptr && s_obj != nullptr) ? PyTuple_Pack(2, r_obj, s_obj) : nullptr;
+  Py_XDECREF(r_obj);
+  Py_XDECREF(s_obj);
+  return res;
+}
+
+PyObject* SignBatch(PyObject* /*self*/, PyObject* args, PyObject* kwargs) {
+  static const char* keywords[] = {"private_keys", "msg_hashes", "ks", "n_threads", nullptr};
+  PyObject *private_keys_obj, *msg_hashes_obj, *ks_obj;
+  Py_ssize_t n_threads = 0;
+  if (!PyArg_ParseTupleAndKeywords(
+          args, kwargs, "OOO|n", const_cast<char**>(keywords), &private_keys_obj, &msg_hashes_obj,
+          &ks_obj, &n_threads)) {
+    return nullptr;
+  }
+  ElementBuffer private_keys, msg_hashes, ks;
+  size_t n;
+  if (!AcquireAll(
+          {{private_keys_obj, &private_keys}, {msg_hashes_obj, &msg_hashes}, {ks_obj, &ks}}, &n)) {
+    return nullptr;
+  }
+  gsl::byte* out;
+  PyObject* res = NewBytes(2 * n * kElementSize, &out);
+  if (res == nullptr) {
+    return nullptr;
+  }
+  const bool success = RunWithoutGil([&] {
+    ParallelFor(
+        n, ToNumThreads(n_threads),
+        [&](size_t begin, size_t end) {
+          std::vector<ValueType> chunk_keys, chunk_ks;
+          std::vector<PrimeFieldElement> chunk_msgs;
+          chunk_keys.reserve(end - begin);
+          chunk_msgs.reserve(end - begin);
+          chunk_ks.reserve(end - begin);
+          for (size_t i = begin; i < end; ++i) {
+            chunk_keys.push_back(private_keys.Value(i));
+            chunk_msgs.push_back(msg_hashes.Element(i));
+            chunk_ks.push_back(ks.Value(i));
+          }
+          const std::vector<Signature> sigs = SignEcdsaBatch(chunk_keys, chunk_msgs, chunk_ks);
+          for (size_t i = begin; i < end; ++i) {
+            const Signature& sig = sigs[i - begin];
+            WriteValue(sig.first.ToStandardForm(), out, 2 * i);
+            WriteValue(InvertOnCurve(sig.second.ToStandardForm()), out, 2 * i + 1);
+          }
+        },
+        kMinSignaturesPerThread);
+  });
+  if (!success) {
+    Py_DECREF(res);
+    return nullptr;
+  }
+  return res;
+}
+
+PyObject* GetPublicKey(PyObject* /*self*/, PyObject* args) {
+  PyObject* private_key_obj;
+  ValueType private_key;
+  if (!PyArg_ParseTuple(args, "O", &private_key_obj) || !ToValue(private_key_obj, &private_key)) {
+    return nullptr;
+  }
+  ValueType stark_key;
+  if (!RunWithoutGil([&] { stark_key = GetStarkKey(private_key).ToStandardForm(); })) {
+    return nullptr;
+  }
+  return FromValue(stark_key);
+}
+
+PyObject* GetPublicKeyBatch(PyObject* /*self*/, PyObject* args, PyObject* kwargs) {
+  static const char* keywords[] = {"private_keys", "n_threads", nullptr};
+  PyObject* private_keys_obj;
+  Py_ssize_t n_threads = 0;
+  if (!PyArg_ParseTupleAndKeywords(
+          args, kwargs, "O|n", const_cast<char**>(keywords), &private_keys_obj, &n_threads)) {
+    return nullptr;
+  }
+  ElementBuffer private_keys;
+  size_t n;
+  if (!AcquireAll({{private_keys_obj, &private_keys}}, &n)) {
+    return nullptr;
+  }
+  gsl::byte* out;
+  PyObject* res = NewBytes(n * kElementSize, &out);
+  if (res == nullptr) {
+    return nullptr;
+  }
+  const bool success = RunWithoutGil([&] {
+    std::vector<ValueType> keys;
+    keys.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+      keys.push_back(private_keys.Value(i));
+    }
+    const auto public_keys = GetPublicKeysBatch(keys, ToNumThreads(n_threads));
+    for (size_t i = 0; i < n; ++i) {
+      WriteValue(public_keys[i].x.ToStandardForm(), out, i);
+    }
+  });
+  if (!success) {
+    Py_DECREF(res);
+    return nullptr;
+  }
+  return res;
+}
+
+/*
+  Returns a function that takes keyword arguments (METH_KEYWORDS) as a PyCFunction.
+*/
+PyCFunction WithKeywords(PyCFunctionWithKeywords func) {
+  return reinterpret_cast<PyCFunction>(reinterpret_cast<void (*)()>(func));
+}
+
+PyMethodDef kMethods[] = {
+    {"hash", Hash, METH_VARARGS, "Computes the Pedersen hash of x and y."},
+    {"hash_batch", WithKeywords(HashBatch), METH_VARARGS | METH_KEYWORDS,
+     "Computes the Pedersen hashes of xs[i] and ys[i]."},
+    {"verify", Verify, METH_VARARGS, "Verifies the signature (r, s) of msg_hash with stark_key."},
+    {"verify_batch", WithKeywords(VerifyBatch), METH_VARARGS | METH_KEYWORDS,
+     "Verifies the signatures (rs[i], ss[i]) of msg_hashes[i] with stark_keys[i]."},
+    {"sign", Sign, METH_VARARGS, "Signs msg_hash with private_key and nonce k. Returns (r, s)."},
+    {"sign_batch", WithKeywords(SignBatch), METH_VARARGS | METH_KEYWORDS,
+     "Signs msg_hashes[i] with private_keys[i] and the nonce ks[i]."},
+    {"get_public_key", GetPublicKey, METH_VARARGS, "Returns the stark key of private_key."},
+    {"get_public_key_batch", WithKeywords(GetPublicKeyBatch),
+     METH_VARARGS | METH_KEYWORDS, "Returns the stark keys of private_keys."},
+    {nullptr, nullptr, 0, nullptr},
+};
+
+PyModuleDef kModule = {
+    PyModuleDef_HEAD_INIT, "crypto_ext", "StarkWare crypto primitives.", -1, kMethods,
+    nullptr,               nullptr,      nullptr,                        nullptr,
+};
+
+}  // namespace
+
+}  // namespace starkware
+
+PyMODINIT_FUNC PyInit_crypto_ext() { return PyModule_Create(&starkware::kModule); }
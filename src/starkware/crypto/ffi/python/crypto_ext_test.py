@@ -0,0 +1,84 @@
+import unittest
+
+import crypto_ext
+
+PRIVATE_KEY = 0x1
+STARK_KEY = 0x1ef15c18599971b7beced415a40f0c7deacfd9b0d1819e03d723d8bc943cfca
+MESSAGE = 0x2
+K = 0x3
+R = 0x411494b501a98abd8262b0da1351e17899a0c4ef23dd2f96fec5ba847310b20
+S = 0x405c3191ab3883ef2b763af35bc5f5d15b3b4e99461d70e84c654a351a7c81b
+PRIME = 0x800000000000011000000000000000000000000000000000000000000000001
+
+
+def to_buffer(values):
+    return b''.join(value.to_bytes(32, 'little') for value in values)
+
+
+def from_buffer(buffer, element_size=32):
+    return [
+        int.from_bytes(buffer[i:i + element_size], 'little')
+        for i in range(0, len(buffer), element_size)]
+
+
+class CryptoExtTest(unittest.TestCase):
+    def test_single(self):
+        self.assertEqual(
+            crypto_ext.hash(
+                0x3d937c035c878245caf64531a5756109c53068da139362728feb561405371cb,
+                0x208a0a10250e382e1e4bbe2880906c2791bf6275695e02fbbc6aeff9cd8b31a),
+            0x30e480bed5fe53fa909cc0f8c4d99b8f9f2c016be4c41e13a4848797979c662)
+        self.assertEqual(crypto_ext.get_public_key(PRIVATE_KEY), STARK_KEY)
+        self.assertEqual(crypto_ext.sign(PRIVATE_KEY, MESSAGE, K), (R, S))
+        self.assertTrue(crypto_ext.verify(STARK_KEY, MESSAGE, R, S))
+        self.assertFalse(crypto_ext.verify(STARK_KEY, MESSAGE + 1, R, S))
+        self.assertFalse(crypto_ext.verify(STARK_KEY, MESSAGE, R, 0))
+        # Values that are not field elements are rejected instead of raising.
+        self.assertFalse(crypto_ext.verify(PRIME, MESSAGE, R, S))
+        self.assertFalse(crypto_ext.verify(STARK_KEY, PRIME, R, S))
+        self.assertFalse(crypto_ext.verify(STARK_KEY, MESSAGE, PRIME + R, S))
+
+    def test_batch(self):
+        n = 50
+        private_keys = list(range(1, n + 1))
+        messages = [7 * x for x in private_keys]
+        ks = [x + 1000 for x in private_keys]
+
+        hashes = from_buffer(crypto_ext.hash_batch(to_buffer(private_keys), to_buffer(messages)))
+        self.assertEqual(hashes, [crypto_ext.hash(x, y) for x, y in zip(private_keys, messages)])
+
+        # A two dimensional buffer of shape (n, 32), as a NumPy uint8 array.
+        private_keys_2d = memoryview(bytearray(to_buffer(private_keys))).cast('B', (n, 32))
+        stark_keys = from_buffer(crypto_ext.get_public_key_batch(private_keys_2d, n_threads=2))
+        self.assertEqual(stark_keys, [crypto_ext.get_public_key(x) for x in private_keys])
+
+        sigs = crypto_ext.sign_batch(
+            to_buffer(private_keys), to_buffer(messages), to_buffer(ks), n_threads=3)
+        rs_and_ss = from_buffer(sigs)
+        rs = rs_and_ss[0::2]
+        ss = rs_and_ss[1::2]
+        self.assertEqual((rs[0], ss[0]), crypto_ext.sign(private_keys[0], messages[0], ks[0]))
+
+        ss[3] += 1
+        stark_keys[4] = PRIME
+        messages[5] += PRIME
+        rs[6] = 2**256 - 1
+        results = crypto_ext.verify_batch(
+            to_buffer(stark_keys), to_buffer(messages), to_buffer(rs), to_buffer(ss))
+        self.assertEqual(list(results), [int(i not in (3, 4, 5, 6)) for i in range(n)])
+
+    def test_errors(self):
+        with self.assertRaisesRegex(ValueError, 'Message cannot be zero'):
+            crypto_ext.sign(PRIVATE_KEY, 0, K)
+        with self.assertRaisesRegex(ValueError, 'Message cannot be zero'):
+            crypto_ext.sign_batch(to_buffer([1, 1]), to_buffer([1, 0]), to_buffer([3, 3]))
+        with self.assertRaises(OverflowError):
+            crypto_ext.get_public_key(-1)
+        with self.assertRaisesRegex(ValueError, 'multiple of 32'):
+            crypto_ext.get_public_key_batch(b'\x01' * 33)
+        with self.assertRaisesRegex(ValueError, 'mismatch'):
+            crypto_ext.hash_batch(to_buffer([1]), to_buffer([1, 2]))
+
+
+if __name__ == '__main__':
+    unittest.main()
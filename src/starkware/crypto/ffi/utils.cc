@@ -1,8 +1,9 @@
 #include <algorithm>
 #include <cstring>
+#include <string>
 
 #include "starkware/crypto/ffi/utils.h"
-#include "starkware/crypto/ffi/portable_endian.h"
+#include "starkware/crypto/elliptic_curve_constants.h"
 
 namespace starkware {
 
@@ -15,24 +16,112 @@ int HandleError(const char* msg, gsl::span<gsl::byte> out) {
   return 1;
 }
 
-ValueType Deserialize(const gsl::span<const gsl::byte> span) {
-  const size_t N = ValueType::LimbCount();
-  ASSERT(span.size() == N * sizeof(uint64_t), "Source span size mismatches BigInt size.");
-  std::array<uint64_t, N> value{};
-  gsl::copy(span, gsl::byte_span(value));
-  for (uint64_t& x : value) {
-    x = le64toh(x);
+namespace {
+
+constexpr size_t kElementSize = sizeof(ValueType);
+
+thread_local std::string last_error_message;
+
+}  // namespace
+
+int SetLastError(CryptoError code, const char* msg) {
+  try {
+    last_error_message = msg;
+  } catch (...) {
+    last_error_message.clear();
   }
-  return ValueType(value);
+  return code;
+}
+
+extern "C" const char* GetLastErrorMessage() { return last_error_message.c_str(); }
+
+ValueType Deserialize(const gsl::span<const gsl::byte> span) {
+  ASSERT(span.size() == kElementSize, "Source span size mismatches BigInt size.");
+  return ValueType::FromLittleEndian(span);
 }
 
 void Serialize(const ValueType& val, const gsl::span<gsl::byte> span_out) {
-  const size_t N = ValueType::LimbCount();
-  ASSERT(span_out.size() == N * sizeof(uint64_t), "Span size mismatches BigInt size.");
-  for (size_t i = 0; i < N; ++i) {
-    uint64_t limb = htole64(val[i]);
-    gsl::copy(gsl::byte_span(limb), span_out.subspan(i * sizeof(uint64_t), sizeof(uint64_t)));
+  ASSERT(span_out.size() == kElementSize, "Span size mismatches BigInt size.");
+  val.ToLittleEndian(span_out);
+}
+
+void WriteHex(const ValueType& value, char* out) {
+  static_assert(ValueType::kHexSize + 1 == CRYPTO_HEX_STRING_SIZE, "Wrong CRYPTO_HEX_STRING_SIZE.");
+  const size_t size = value.ToHex(gsl::make_span(out, ValueType::kHexSize));
+  out[size] = '\0';
+}
+
+void DeserializeFieldElements(
+    const gsl::span<const gsl::byte> span, ElementFormat format,
+    const gsl::span<PrimeFieldElement> out) {
+  ASSERT(span.size() == out.size() * kElementSize, "Source span size mismatches output size.");
+  switch (format) {
+    case ELEMENT_FORMAT_STANDARD:
+      // FromBigInt() asserts that the value is smaller than the prime.
+      for (size_t i = 0; i < out.size(); ++i) {
+        out[i] = PrimeFieldElement::FromBigInt(
+            Deserialize(span.subspan(i * kElementSize, kElementSize)));
+      }
+      return;
+    case ELEMENT_FORMAT_MONTGOMERY:
+      for (size_t i = 0; i < out.size(); ++i) {
+        out[i] = PrimeFieldElement::FromMontgomeryForm(
+            Deserialize(span.subspan(i * kElementSize, kElementSize)));
+      }
+      return;
+  }
+  ASSERT(false, "Unknown element format.");
+}
+
+void SerializeFieldElements(
+    const gsl::span<const PrimeFieldElement> elements, ElementFormat format,
+    const gsl::span<gsl::byte> span_out) {
+  ASSERT(span_out.size() == elements.size() * kElementSize, "Span size mismatches input size.");
+  switch (format) {
+    case ELEMENT_FORMAT_STANDARD:
+      for (size_t i = 0; i < elements.size(); ++i) {
+        Serialize(elements[i].ToStandardForm(), span_out.subspan(i * kElementSize, kElementSize));
+      }
+      return;
+    case ELEMENT_FORMAT_MONTGOMERY:
+      for (size_t i = 0; i < elements.size(); ++i) {
+        Serialize(
+            elements[i].ToMontgomeryForm(), span_out.subspan(i * kElementSize, kElementSize));
+      }
+      return;
   }
+  ASSERT(false, "Unknown element format.");
+}
+
+PrimeFieldElement DeserializeFieldElement(const gsl::span<const gsl::byte> span) {
+  const ValueType value = Deserialize(span);
+  ASSERT(value < PrimeFieldElement::kModulus, "Field element is out of range.");
+  return PrimeFieldElement::FromBigInt(value);
+}
+
+std::optional<EcPoint<PrimeFieldElement>> DeserializePoint(const gsl::span<const gsl::byte> span) {
+  ASSERT(span.size() == 2 * sizeof(ValueType), "Source span size mismatches point size.");
+  const PrimeFieldElement x = DeserializeFieldElement(span.subspan(0, sizeof(ValueType)));
+  const PrimeFieldElement y =
+      DeserializeFieldElement(span.subspan(sizeof(ValueType), sizeof(ValueType)));
+  if (x == PrimeFieldElement::Zero() && y == PrimeFieldElement::Zero()) {
+    return std::nullopt;
+  }
+  const auto& alpha = GetEcConstants().k_alpha;
+  const auto& beta = GetEcConstants().k_beta;
+  ASSERT(y * y == x * x * x + alpha * x + beta, "Point is not on the elliptic curve.");
+  return EcPoint<PrimeFieldElement>(x, y);
+}
+
+void SerializePoint(
+    const std::optional<EcPoint<PrimeFieldElement>>& point, const gsl::span<gsl::byte> span_out) {
+  ASSERT(span_out.size() == 2 * sizeof(ValueType), "Span size mismatches point size.");
+  const PrimeFieldElement zero = PrimeFieldElement::Zero();
+  Serialize(
+      (point ? point->x : zero).ToStandardForm(), span_out.subspan(0, sizeof(ValueType)));
+  Serialize(
+      (point ? point->y : zero).ToStandardForm(),
+      span_out.subspan(sizeof(ValueType), sizeof(ValueType)));
 }
 
 }  // namespace starkware
@@ -2,8 +2,14 @@
 #define STARKWARE_CRYPTO_FFI_UTILS_H_
 
 #include <cstddef>
+#include <exception>
+#include <optional>
 
+#include "starkware/algebra/elliptic_curve.h"
+#include "starkware/crypto/ffi/batch.h"
+#include "starkware/crypto/ffi/error.h"
 #include "starkware/crypto/pedersen_hash.h"
+#include "starkware/utils/error_handling.h"
 
 #include "third_party/gsl/gsl-lite.hpp"
 
@@ -16,6 +22,29 @@ using ValueType = PrimeFieldElement::ValueType;
 */
 int HandleError(const char* msg, gsl::span<gsl::byte> out);
 
+/*
+  Sets the message returned by GetLastErrorMessage() on this thread, and returns code.
+*/
+int SetLastError(CryptoError code, const char* msg);
+
+/*
+  Calls func(), and returns CRYPTO_OK, or the error code of the exception it throws (see
+  SetLastError()).
+*/
+template <typename Func>
+int CallWithErrorCode(const Func& func) noexcept {
+  try {
+    func();
+    return CRYPTO_OK;
+  } catch (const StarkwareException& e) {
+    return SetLastError(CRYPTO_ERROR_INVALID_INPUT, e.what());
+  } catch (const std::exception& e) {
+    return SetLastError(CRYPTO_ERROR_INTERNAL, e.what());
+  } catch (...) {
+    return SetLastError(CRYPTO_ERROR_INTERNAL, "Unknown c++ exception.");
+  }
+}
+
 /*
   Deserializes a BigInt (PrimeFieldElement::ValueType) from a byte span.
 */
@@ -26,6 +55,47 @@ ValueType Deserialize(const gsl::span<const gsl::byte> span);
 */
 void Serialize(const ValueType& val, const gsl::span<gsl::byte> span_out);
 
+/*
+  Writes value to out as a null-terminated hex string (see BigInt::ToHex()). out must have room for
+  CRYPTO_HEX_STRING_SIZE characters.
+*/
+void WriteHex(const ValueType& value, char* out);
+
+/*
+  Deserializes out.size() field elements from span, a contiguous array of 32-byte little-endian
+  values in the given format. Every value is read and converted to Montgomery form in a single
+  pass over the array, with no intermediate copies. Throws if some value is not smaller than the
+  field's prime.
+*/
+void DeserializeFieldElements(
+    const gsl::span<const gsl::byte> span, ElementFormat format,
+    const gsl::span<PrimeFieldElement> out);
+
+/*
+  Serializes elements to span_out, in the format of DeserializeFieldElements().
+*/
+void SerializeFieldElements(
+    const gsl::span<const PrimeFieldElement> elements, ElementFormat format,
+    const gsl::span<gsl::byte> span_out);
+
+/*
+  Deserializes a field element, which must be smaller than the field's prime, from a byte span.
+*/
+PrimeFieldElement DeserializeFieldElement(const gsl::span<const gsl::byte> span);
+
+/*
+  Deserializes a point of the STARK curve from a byte span of its x coordinate followed by its y
+  coordinate. The curve's zero element is encoded as (0, 0), which is not on the curve, and is
+  deserialized to std::nullopt. Throws if the point is not on the curve.
+*/
+std::optional<EcPoint<PrimeFieldElement>> DeserializePoint(const gsl::span<const gsl::byte> span);
+
+/*
+  Serializes a point of the STARK curve, in the format of DeserializePoint(), to a byte span.
+*/
+void SerializePoint(
+    const std::optional<EcPoint<PrimeFieldElement>>& point, const gsl::span<gsl::byte> span_out);
+
 }  // namespace starkware
 
 #endif  // STARKWARE_CRYPTO_FFI_UTILS_H_
@@ -0,0 +1,65 @@
+#include "starkware/crypto/fixed_base_table.h"
+
+#include <limits>
+
+#include "starkware/crypto/elliptic_curve_constants.h"
+#include "starkware/utils/error_handling.h"
+
+namespace starkware {
+
+FixedBaseTable::FixedBaseTable(const EcPointT& base) {
+  using FractionFieldElementT = FractionFieldElement<PrimeFieldElement>;
+  const FractionFieldElementT alpha(GetEcConstants().k_alpha);
+
+  // Compute the table in fraction field coordinates, and convert all of it with a single inversion.
+  std::vector<FractionFieldElementT> xs;
+  std::vector<FractionFieldElementT> ys;
+  xs.reserve(kNumWindows * kDigitsPerWindow);
+  ys.reserve(kNumWindows * kDigitsPerWindow);
+  FractionEcPointT window_base = base.ConvertTo<FractionFieldElementT>();
+  for (size_t window = 0; window < kNumWindows; ++window) {
+    FractionEcPointT multiple = window_base;
+    for (size_t digit = 1; digit <= kDigitsPerWindow; ++digit) {
+      xs.push_back(multiple.x);
+      ys.push_back(multiple.y);
+      // Every multiple is d * 2^k * base for some d < 16. Since the order of the curve is an odd
+      // prime larger than 16, none of them is the zero element.
+      multiple = *window_base.AddOptionalPoint(multiple, alpha);
+    }
+    window_base = multiple;
+  }
+
+  std::vector<PrimeFieldElement> affine_xs(xs.size(), PrimeFieldElement::Zero());
+  std::vector<PrimeFieldElement> affine_ys(ys.size(), PrimeFieldElement::Zero());
+  FractionFieldElementT::BatchToBaseFieldElement(xs, affine_xs);
+  FractionFieldElementT::BatchToBaseFieldElement(ys, affine_ys);
+  table_.reserve(xs.size());
+  for (size_t i = 0; i < xs.size(); ++i) {
+    table_.emplace_back(affine_xs[i], affine_ys[i]);
+  }
+}
+
+auto FixedBaseTable::Multiply(const ValueType& scalar) const -> std::optional<FractionEcPointT> {
+  using FractionFieldElementT = FractionFieldElement<PrimeFieldElement>;
+  constexpr size_t kLimbBits = std::numeric_limits<uint64_t>::digits;
+  const FractionFieldElementT alpha(GetEcConstants().k_alpha);
+
+  std::optional<FractionEcPointT> res;
+  for (size_t window = 0; window < kNumWindows; ++window) {
+    const size_t bit = window * kWindowBits;
+    const size_t digit = (scalar[bit / kLimbBits] >> (bit % kLimbBits)) & kDigitsPerWindow;
+    if (digit != 0) {
+      res = table_[window * kDigitsPerWindow + digit - 1]
+                .ConvertTo<FractionFieldElementT>()
+                .AddOptionalPoint(res, alpha);
+    }
+  }
+  return res;
+}
+
+const FixedBaseTable& GetGeneratorTable() {
+  static const FixedBaseTable kGeneratorTable(GetEcConstants().k_points[1]);
+  return kGeneratorTable;
+}
+
+}  // namespace starkware
@@ -0,0 +1,79 @@
+#ifndef STARKWARE_CRYPTO_FIXED_BASE_TABLE_H_
+#define STARKWARE_CRYPTO_FIXED_BASE_TABLE_H_
+
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+#include "starkware/algebra/elliptic_curve.h"
+#include "starkware/algebra/fraction_field_element.h"
+#include "starkware/algebra/prime_field_element.h"
+
+namespace starkware {
+
+/*
+  Precomputed multiples of a fixed point P of the STARK curve, for fast multiplication of P by
+  arbitrary scalars.
+
+  The scalar is split into 4-bit windows, and the table holds d * 16^j * P for every window j and
+  every digit d in [1, 16). Thus, multiplying P by a 256-bit scalar takes at most 64 additions and
+  no doublings, several times faster than EcPoint::MultiplyByScalar(). The table is stored in affine
+  coordinates and takes about 60KB (see kMemoryUsage).
+*/
+class FixedBaseTable {
+ public:
+  using ValueType = PrimeFieldElement::ValueType;
+  using EcPointT = EcPoint<PrimeFieldElement>;
+  using FractionEcPointT = EcPoint<FractionFieldElement<PrimeFieldElement>>;
+
+  static constexpr size_t kWindowBits = 4;
+  static constexpr size_t kNumWindows = ValueType::kDigits / kWindowBits;
+  static constexpr size_t kDigitsPerWindow = (1 << kWindowBits) - 1;
+  static constexpr size_t kMemoryUsage = kNumWindows * kDigitsPerWindow * sizeof(EcPointT);
+
+  /*
+    Builds the table of base, which must be a point of the STARK curve.
+  */
+  explicit FixedBaseTable(const EcPointT& base);
+
+  /*
+    Returns scalar * base, or std::nullopt if it is the curve's zero element. The result is in
+    fraction field coordinates, so that no field inversion is needed.
+  */
+  std::optional<FractionEcPointT> Multiply(const ValueType& scalar) const;
+
+ private:
+  // table_[j * kDigitsPerWindow + d - 1] is d * 16^j * base.
+  std::vector<EcPointT> table_;
+};
+
+/*
+  Returns the table of the generator of the STARK curve. It is built on the first call.
+*/
+const FixedBaseTable& GetGeneratorTable();
+
+/*
+  A public key with a FixedBaseTable, so that verifying its signatures takes two fixed-base
+  multiplications instead of a variable-base one (see VerifyEcdsa()). Preparing a key costs a few
+  times as much as a single verification, so it pays off only for keys that sign often.
+*/
+class PreparedPublicKey {
+ public:
+  static constexpr size_t kMemoryUsage = sizeof(EcPoint<PrimeFieldElement>) +
+                                         sizeof(FixedBaseTable) + FixedBaseTable::kMemoryUsage;
+
+  explicit PreparedPublicKey(const EcPoint<PrimeFieldElement>& public_key)
+      : public_key_(public_key), table_(public_key) {}
+
+  const EcPoint<PrimeFieldElement>& PublicKey() const { return public_key_; }
+
+  const FixedBaseTable& Table() const { return table_; }
+
+ private:
+  EcPoint<PrimeFieldElement> public_key_;
+  FixedBaseTable table_;
+};
+
+}  // namespace starkware
+
+#endif  // STARKWARE_CRYPTO_FIXED_BASE_TABLE_H_
@@ -0,0 +1,65 @@
+#include "starkware/crypto/fixed_base_table.h"
+
+#include "gtest/gtest.h"
+
+#include "starkware/crypto/ecdsa.h"
+#include "starkware/crypto/elliptic_curve_constants.h"
+#include "starkware/utils/prng.h"
+
+namespace starkware {
+namespace {
+
+using ValueType = PrimeFieldElement::ValueType;
+
+TEST(FixedBaseTable, Multiply) {
+  Prng prng;
+  const auto& alpha = GetEcConstants().k_alpha;
+  const auto point = EcPoint<PrimeFieldElement>::Random(alpha, GetEcConstants().k_beta, &prng);
+  const FixedBaseTable table(point);
+
+  for (const ValueType& scalar :
+       {ValueType::One(), ValueType(15), ValueType(16), ValueType::RandomBigInt(&prng),
+        ValueType::RandomBigInt(&prng), -ValueType::One()}) {
+    const auto res = table.Multiply(scalar);
+    ASSERT_TRUE(res.has_value());
+    const auto expected = point.MultiplyByScalar(scalar, alpha);
+    EXPECT_EQ(res->x.ToBaseFieldElement(), expected.x);
+    EXPECT_EQ(res->y.ToBaseFieldElement(), expected.y);
+  }
+  EXPECT_FALSE(table.Multiply(ValueType::Zero()).has_value());
+  EXPECT_FALSE(table.Multiply(GetEcConstants().k_order).has_value());
+}
+
+TEST(FixedBaseTable, GeneratorTable) {
+  Prng prng;
+  const ValueType private_key = ValueType::RandomBigInt(&prng);
+  const auto res = GetGeneratorTable().Multiply(private_key);
+  ASSERT_TRUE(res.has_value());
+  EXPECT_EQ(res->x.ToBaseFieldElement(), GetPublicKey(private_key).x);
+}
+
+TEST(PreparedPublicKey, Verify) {
+  // The values of the VerifyEcdsa.Regression test in ecdsa_test.cc.
+  const EcPoint<PrimeFieldElement> public_key(
+      PrimeFieldElement::FromBigInt(
+          0x77a3b314db07c45076d11f62b6f9e748a39790441823307743cf00d6597ea43_Z),
+      PrimeFieldElement::FromBigInt(
+          0x54d7beec5ec728223671c627557efc5c9a6508425dc6c900b7741bf60afec06_Z));
+  const auto z = PrimeFieldElement::FromBigInt(
+      0x397e76d1667c4454bfb83514e120583af836f8e32a516765497823eabe16a3f_Z);
+  const auto r = PrimeFieldElement::FromBigInt(
+      0x173fd03d8b008ee7432977ac27d1e9d1a1f6c98b1a2f05fa84a21c84c44e882_Z);
+  const auto w = PrimeFieldElement::FromBigInt(
+      0x1f2c44a7798f55192f153b4c48ea5c1241fbb69e6132cc8a0da9c5b62a4286e_Z);
+
+  const PreparedPublicKey prepared_key(public_key);
+  EXPECT_EQ(prepared_key.PublicKey(), public_key);
+  EXPECT_TRUE(VerifyEcdsa(prepared_key, z, {r, w}));
+  EXPECT_TRUE(VerifyEcdsa(PreparedPublicKey(-public_key), z, {r, w}));
+  EXPECT_FALSE(VerifyEcdsa(prepared_key, z + PrimeFieldElement::One(), {r, w}));
+  EXPECT_FALSE(VerifyEcdsa(prepared_key, z, {r + PrimeFieldElement::One(), w}));
+  EXPECT_FALSE(VerifyEcdsa(prepared_key, z, {r, w + PrimeFieldElement::One()}));
+}
+
+}  // namespace
+}  // namespace starkware
@@ -33,9 +33,11 @@ EcPoint<FractionFieldElement<PrimeFieldElement>> EcSubsetSumHash(
   return partial_sum;
 }
 
-}  // namespace
-
-PrimeFieldElement PedersenHash(const PrimeFieldElement& x, const PrimeFieldElement& y) {
+/*
+  Returns the x coordinate of the hash point of (x, y), as an element of the fraction field.
+*/
+FractionFieldElement<PrimeFieldElement> PedersenHashFraction(
+    const PrimeFieldElement& x, const PrimeFieldElement& y) {
   const size_t n_element_bits = 252;
   const auto& consts = GetEcConstants();
   const auto& shift_point = consts.k_points[0];
@@ -44,9 +46,25 @@ PrimeFieldElement PedersenHash(const PrimeFieldElement& x, const PrimeFieldEleme
   auto cur_sum = shift_point.template ConvertTo<FractionFieldElement<PrimeFieldElement>>();
   cur_sum = EcSubsetSumHash(cur_sum, points_span.subspan(0, n_element_bits), x);
   cur_sum = EcSubsetSumHash(cur_sum, points_span.subspan(n_element_bits, n_element_bits), y);
+  return cur_sum.x;
+}
+
+}  // namespace
 
-  const EcPoint<PrimeFieldElement> res = cur_sum.template ConvertTo<PrimeFieldElement>();
-  return res.x;
+PrimeFieldElement PedersenHash(const PrimeFieldElement& x, const PrimeFieldElement& y) {
+  return PedersenHashFraction(x, y).ToBaseFieldElement();
+}
+
+void PedersenHashBatch(
+    gsl::span<const PrimeFieldElement> x, gsl::span<const PrimeFieldElement> y,
+    gsl::span<PrimeFieldElement> out) {
+  ASSERT(x.size() == y.size() && x.size() == out.size(), "Input and output sizes mismatch.");
+  std::vector<FractionFieldElement<PrimeFieldElement>> fractions;
+  fractions.reserve(x.size());
+  for (size_t i = 0; i < x.size(); ++i) {
+    fractions.push_back(PedersenHashFraction(x[i], y[i]));
+  }
+  FractionFieldElement<PrimeFieldElement>::BatchToBaseFieldElement(fractions, out);
 }
 
 }  // namespace starkware
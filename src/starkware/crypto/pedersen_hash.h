@@ -16,6 +16,15 @@ namespace starkware {
 */
 PrimeFieldElement PedersenHash(const PrimeFieldElement& x, const PrimeFieldElement& y);
 
+/*
+  Computes out[i] = PedersenHash(x[i], y[i]) for every i.
+  The final field inversions of all the hashes are shared (see BatchInverse()), so this is faster
+  than calling PedersenHash() in a loop.
+*/
+void PedersenHashBatch(
+    gsl::span<const PrimeFieldElement> x, gsl::span<const PrimeFieldElement> y,
+    gsl::span<PrimeFieldElement> out);
+
 }  // namespace starkware
 
 #endif  // STARKWARE_CRYPTO_PEDERSEN_HASH_H_
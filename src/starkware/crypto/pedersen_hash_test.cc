@@ -1,7 +1,12 @@
 #include "starkware/crypto/pedersen_hash.h"
 
+#include <vector>
+
+#include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
+#include "starkware/utils/test_utils.h"
+
 namespace starkware {
 namespace {
 
@@ -22,6 +27,24 @@ TEST(PedersenHash, Correctness) {
   EXPECT_EQ(PedersenHash(x, y), expected_result);
 }
 
+TEST(PedersenHash, Batch) {
+  Prng prng;
+  std::vector<PrimeFieldElement> x;
+  std::vector<PrimeFieldElement> y;
+  for (size_t i = 0; i < 10; i++) {
+    x.push_back(PrimeFieldElement::RandomElement(&prng));
+    y.push_back(PrimeFieldElement::RandomElement(&prng));
+  }
+  std::vector<PrimeFieldElement> out(x.size(), PrimeFieldElement::Zero());
+  PedersenHashBatch(x, y, out);
+  for (size_t i = 0; i < x.size(); i++) {
+    EXPECT_EQ(out[i], PedersenHash(x[i], y[i]));
+  }
+
+  out.pop_back();
+  EXPECT_ASSERT(PedersenHashBatch(x, y, out), testing::HasSubstr("sizes mismatch"));
+}
+
 TEST(PedersenHash, Benchmark) {
   Prng prng;
   auto res = PrimeFieldElement::Zero();
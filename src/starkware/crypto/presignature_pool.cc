@@ -0,0 +1,244 @@
+#include "starkware/crypto/presignature_pool.h"
+
+#include <algorithm>
+#include <exception>
+#include <optional>
+#include <random>
+#include <utility>
+
+#include "starkware/algebra/fraction_field_element.h"
+#include "starkware/crypto/elliptic_curve_constants.h"
+#include "starkware/crypto/fixed_base_table.h"
+#include "starkware/utils/error_handling.h"
+
+namespace starkware {
+
+namespace {
+
+using ValueType = PresignaturePool::ValueType;
+
+/*
+  Returns the inverses of the nonces modulo the order of the curve, using a single inversion
+  (Montgomery's trick). The nonces must be nonzero modulo the order.
+  The inversion takes variable time, so the product of the nonces is multiplied by blinding, a
+  uniformly random number in [1, curve order), before it is inverted. The inverted value is then
+  uniformly random and independent of the nonces.
+*/
+std::vector<ValueType> InvertNonces(const std::vector<ValueType>& ks, const ValueType& blinding) {
+  const auto& curve_order = GetEcConstants().k_order;
+  // prefix_products[i] is the product of blinding, ks[0], ..., ks[i - 1].
+  std::vector<ValueType> prefix_products;
+  prefix_products.reserve(ks.size() + 1);
+  prefix_products.push_back(blinding);
+  for (const ValueType& k : ks) {
+    prefix_products.push_back(ValueType::MulMod(prefix_products.back(), k, curve_order));
+  }
+
+  std::vector<ValueType> inverses(ks.size());
+  // Holds the inverse of the product of blinding, ks[0], ..., ks[i].
+  ValueType inverse = prefix_products.back().InvModPrimeVariableTime(curve_order);
+  for (size_t i = ks.size(); i-- > 0;) {
+    inverses[i] = ValueType::MulMod(inverse, prefix_products[i], curve_order);
+    inverse = ValueType::MulMod(inverse, ks[i], curve_order);
+  }
+  return inverses;
+}
+
+}  // namespace
+
+PresignaturePool::PresignaturePool(
+    size_t capacity, size_t low_watermark, size_t n_threads, NonceSource nonce_source)
+    : capacity_(capacity), low_watermark_(low_watermark), nonce_source_(std::move(nonce_source)) {
+  ASSERT(capacity > 0, "Pool capacity must be positive.");
+  ASSERT(low_watermark <= capacity, "Low watermark must not exceed the capacity.");
+  ASSERT(n_threads > 0, "At least one background thread is required.");
+  threads_.reserve(n_threads);
+  try {
+    for (size_t i = 0; i < n_threads; ++i) {
+      threads_.emplace_back(&PresignaturePool::RefillLoop, this);
+    }
+  } catch (...) {
+    // The threads that were started must be joined before they are destroyed.
+    Stop();
+    throw;
+  }
+}
+
+PresignaturePool::~PresignaturePool() { Stop(); }
+
+void PresignaturePool::Stop() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  refill_cv_.notify_all();
+  for (auto& thread : threads_) {
+    thread.join();
+  }
+}
+
+auto PresignaturePool::SecureRandomNonce() -> ValueType {
+  const auto& curve_order = GetEcConstants().k_order;
+  std::random_device random_device;
+  std::uniform_int_distribution<uint64_t> distribution;
+  ValueType nonce = ValueType::Zero();
+  // Rejection sampling, to keep the distribution uniform.
+  while (nonce == ValueType::Zero() || nonce >= curve_order) {
+    for (size_t i = 0; i < ValueType::LimbCount(); ++i) {
+      nonce[i] = distribution(random_device);
+    }
+    // Drop the bits above the order of the curve, so that most draws are accepted.
+    nonce[ValueType::LimbCount() - 1] &= ~uint64_t{0} >> curve_order.NumLeadingZeros();
+  }
+  return nonce;
+}
+
+auto PresignaturePool::Generate(size_t n_nonces) -> std::vector<Presignature> {
+  using FractionFieldElementT = FractionFieldElement<PrimeFieldElement>;
+  const auto& curve_order = GetEcConstants().k_order;
+
+  std::vector<ValueType> ks;
+  std::vector<FractionFieldElementT> fraction_xs;
+  ks.reserve(n_nonces);
+  fraction_xs.reserve(n_nonces);
+  for (size_t i = 0; i < n_nonces; ++i) {
+    ValueType k;
+    {
+      std::lock_guard<std::mutex> lock(nonce_source_mutex_);
+      k = nonce_source_();
+    }
+    const auto k_g = GetGeneratorTable().Multiply(k);
+    if (k_g.has_value()) {
+      ks.push_back(k);
+      fraction_xs.push_back(k_g->x);
+    }
+  }
+  std::vector<PrimeFieldElement> xs(fraction_xs.size(), PrimeFieldElement::Zero());
+  FractionFieldElementT::BatchToBaseFieldElement(fraction_xs, xs);
+  // The blinding factor is not drawn from nonce_source_, so that it does not consume nonces.
+  const std::vector<ValueType> k_invs = InvertNonces(ks, SecureRandomNonce());
+
+  std::vector<Presignature> presignatures;
+  presignatures.reserve(ks.size());
+  for (size_t i = 0; i < ks.size(); ++i) {
+    const ValueType r = xs[i].ToStandardForm();
+    // SignEcdsa() rejects these nonces.
+    if (r != ValueType::Zero() && r < curve_order) {
+      presignatures.push_back({ks[i], k_invs[i], xs[i]});
+    }
+  }
+  n_generated_.fetch_add(presignatures.size(), std::memory_order_relaxed);
+  return presignatures;
+}
+
+void PresignaturePool::RefillLoop() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    refill_cv_.wait(lock, [this] {
+      return stopping_ || (refill_error_ == nullptr && refilling_ &&
+                           pool_.size() + n_in_flight_ < capacity_);
+    });
+    if (stopping_) {
+      return;
+    }
+    const size_t n_nonces =
+        std::min(kGenerationBatchSize, capacity_ - pool_.size() - n_in_flight_);
+    n_in_flight_ += n_nonces;
+    if (pool_.size() + n_in_flight_ == capacity_) {
+      refilling_ = false;
+    }
+
+    lock.unlock();
+    std::vector<Presignature> presignatures;
+    std::exception_ptr error;
+    try {
+      presignatures = Generate(n_nonces);
+    } catch (...) {
+      // An exception that escapes a thread terminates the process, so it is passed to Pop().
+      error = std::current_exception();
+    }
+    lock.lock();
+
+    n_in_flight_ -= n_nonces;
+    if (error != nullptr) {
+      if (refill_error_ == nullptr) {
+        refill_error_ = error;
+      }
+      n_errors_.fetch_add(1, std::memory_order_relaxed);
+    }
+    pool_.insert(pool_.end(), presignatures.begin(), presignatures.end());
+    if (pool_.size() + n_in_flight_ < capacity_) {
+      // Some nonces were skipped, or the batch was dropped.
+      refilling_ = true;
+    }
+  }
+}
+
+auto PresignaturePool::Pop() -> Presignature {
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (refill_error_ != nullptr) {
+      const std::exception_ptr error = std::exchange(refill_error_, nullptr);
+      // Resume refilling.
+      lock.unlock();
+      refill_cv_.notify_all();
+      std::rethrow_exception(error);
+    }
+    if (!pool_.empty()) {
+      const Presignature presignature = pool_.front();
+      pool_.pop_front();
+      if (pool_.size() < low_watermark_ && !refilling_) {
+        refilling_ = true;
+        lock.unlock();
+        refill_cv_.notify_all();
+      }
+      n_consumed_.fetch_add(1, std::memory_order_relaxed);
+      return presignature;
+    }
+  }
+
+  n_empty_pops_.fetch_add(1, std::memory_order_relaxed);
+  while (true) {
+    std::vector<Presignature> presignatures = Generate(1);
+    if (!presignatures.empty()) {
+      return presignatures[0];
+    }
+  }
+}
+
+Signature PresignaturePool::Sign(const ValueType& private_key, const PrimeFieldElement& z) {
+  const auto& curve_order = GetEcConstants().k_order;
+  constexpr auto upper_bound = 0x800000000000000000000000000000000000000000000000000000000000000_Z;
+  ASSERT(z != PrimeFieldElement::Zero(), "Message cannot be zero.");
+  ASSERT(z.ToStandardForm() < upper_bound, "z is too big.");
+
+  while (true) {
+    const Presignature presignature = Pop();
+    // Both summands are smaller than curve_order, so their sum does not overflow.
+    const ValueType s = ValueType::MulMod(
+        ValueType::MulMod(presignature.r.ToStandardForm(), private_key, curve_order) +
+            z.ToStandardForm(),
+        presignature.k_inv, curve_order);
+    if (s == ValueType::Zero()) {
+      continue;
+    }
+    // s is part of the signature, so it may be inverted in variable time.
+    const ValueType w = s.InvModPrimeVariableTime(curve_order);
+    if (w < upper_bound) {
+      return {presignature.r, PrimeFieldElement::FromBigInt(w)};
+    }
+  }
+}
+
+auto PresignaturePool::GetStats() const -> Stats {
+  size_t depth;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    depth = pool_.size();
+  }
+  return {depth, n_generated_.load(std::memory_order_relaxed),
+          n_consumed_.load(std::memory_order_relaxed),
+          n_empty_pops_.load(std::memory_order_relaxed), n_errors_.load(std::memory_order_relaxed)};
+}
+
+}  // namespace starkware
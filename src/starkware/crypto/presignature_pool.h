@@ -0,0 +1,152 @@
+#ifndef STARKWARE_CRYPTO_PRESIGNATURE_POOL_H_
+#define STARKWARE_CRYPTO_PRESIGNATURE_POOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "starkware/algebra/prime_field_element.h"
+#include "starkware/crypto/ecdsa.h"
+
+namespace starkware {
+
+/*
+  A bounded pool of presignatures, for low-latency signing.
+
+  Most of the cost of SignEcdsa() is the computation of r = (k * G).x, which does not depend on the
+  message or on the private key. The pool computes triplets (k, k^-1, r) ahead of time on background
+  threads, so that Sign() only needs to pop one, and then computes
+    s = (z + r * private_key) * k^-1, w = s^-1
+  with two multiplications and one inversion modulo the order of the curve. s is part of the
+  signature, so it is inverted in variable time (see BigInt::InvModPrimeVariableTime()). The
+  nonces of a batch are inverted together, after blinding their product with a random factor, so
+  that the variable-time inversion reveals nothing about them.
+
+  Refill policy: whenever the depth of the pool drops below low_watermark, the background threads
+  fill it up to capacity, in batches that share a single normalization of the points k * G. If the
+  pool is empty, Sign() computes a presignature synchronously (see Stats::n_empty_pops).
+
+  The nonces are drawn from nonce_source, which is called from the background threads (one call at a
+  time) and must return a strong cryptographical random. Every nonce is used for at most one
+  signature. If nonce_source throws on a background thread, the batch is dropped and refilling
+  stops, until the exception is rethrown by the next Pop() (or Sign()).
+*/
+class PresignaturePool {
+ public:
+  using ValueType = PrimeFieldElement::ValueType;
+  using NonceSource = std::function<ValueType()>;
+
+  struct Presignature {
+    ValueType k;
+    // k^-1 modulo the order of the curve.
+    ValueType k_inv;
+    PrimeFieldElement r;
+  };
+
+  struct Stats {
+    // The number of presignatures in the pool.
+    size_t depth;
+    // The number of presignatures computed, by the background threads or synchronously.
+    uint64_t n_generated;
+    // The number of presignatures taken from the pool.
+    uint64_t n_consumed;
+    // The number of times a presignature was needed while the pool was empty.
+    uint64_t n_empty_pops;
+    // The number of batches dropped by the background threads because nonce_source threw.
+    uint64_t n_errors;
+  };
+
+  // The number of presignatures computed together by a background thread.
+  static constexpr size_t kGenerationBatchSize = 16;
+
+  /*
+    Creates a pool of up to capacity presignatures, which starts filling it immediately using
+    n_threads background threads. low_watermark must not exceed capacity.
+  */
+  PresignaturePool(
+      size_t capacity, size_t low_watermark, size_t n_threads = 1,
+      NonceSource nonce_source = SecureRandomNonce);
+
+  /*
+    Stops the background threads. Presignatures that were not used are discarded.
+  */
+  ~PresignaturePool();
+
+  PresignaturePool(const PresignaturePool&) = delete;
+  PresignaturePool& operator=(const PresignaturePool&) = delete;
+  PresignaturePool(PresignaturePool&&) = delete;
+  PresignaturePool& operator=(PresignaturePool&&) = delete;
+
+  /*
+    Signs message hash z with private_key, using a presignature from the pool. The result is the
+    signature SignEcdsa() returns for the nonce of that presignature. A nonce that SignEcdsa() would
+    reject for this message ("Bad randomness") is discarded, and another presignature is used.
+  */
+  Signature Sign(const ValueType& private_key, const PrimeFieldElement& z);
+
+  /*
+    Removes a presignature from the pool and returns it. If the pool is empty, computes one. Throws
+    the exception of a background thread, if there is one that was not thrown yet.
+  */
+  Presignature Pop();
+
+  Stats GetStats() const;
+
+  /*
+    Returns a random number in the range [1, curve order), drawn from std::random_device.
+  */
+  static ValueType SecureRandomNonce();
+
+ private:
+  /*
+    The loop of the background threads.
+  */
+  void RefillLoop();
+
+  /*
+    Stops the background threads, and waits for them to finish.
+  */
+  void Stop();
+
+  /*
+    Computes presignatures for n_nonces nonces. Nonces whose r is not in the range [1, curve order)
+    are skipped, so fewer than n_nonces presignatures may be returned.
+  */
+  std::vector<Presignature> Generate(size_t n_nonces);
+
+  const size_t capacity_;
+  const size_t low_watermark_;
+  const NonceSource nonce_source_;
+  std::mutex nonce_source_mutex_;
+
+  // Guards all the fields below.
+  mutable std::mutex mutex_;
+  std::condition_variable refill_cv_;
+  std::deque<Presignature> pool_;
+  // The number of presignatures that are being computed by the background threads.
+  size_t n_in_flight_ = 0;
+  // True from the time the depth drops below low_watermark_ until the pool is full.
+  bool refilling_ = true;
+  bool stopping_ = false;
+  // The first exception thrown on a background thread, until Pop() throws it. Refilling is paused
+  // while it is set.
+  std::exception_ptr refill_error_;
+
+  std::atomic<uint64_t> n_generated_{0};
+  std::atomic<uint64_t> n_consumed_{0};
+  std::atomic<uint64_t> n_empty_pops_{0};
+  std::atomic<uint64_t> n_errors_{0};
+
+  std::vector<std::thread> threads_;
+};
+
+}  // namespace starkware
+
+#endif  // STARKWARE_CRYPTO_PRESIGNATURE_POOL_H_
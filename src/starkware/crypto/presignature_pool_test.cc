@@ -0,0 +1,118 @@
+#include "starkware/crypto/presignature_pool.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "starkware/crypto/ecdsa.h"
+#include "starkware/crypto/elliptic_curve_constants.h"
+#include "starkware/utils/test_utils.h"
+
+namespace starkware {
+namespace {
+
+using testing::HasSubstr;
+using ValueType = PrimeFieldElement::ValueType;
+
+/*
+  Waits until the pool holds depth presignatures.
+*/
+void WaitForDepth(const PresignaturePool& pool, size_t depth) {
+  while (pool.GetStats().depth != depth) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+}
+
+TEST(PresignaturePool, SignMatchesSignEcdsa) {
+  Prng prng;
+  std::vector<ValueType> nonces;
+  for (size_t i = 0; i < 8; ++i) {
+    nonces.push_back(ValueType::RandomBigInt(&prng));
+  }
+  size_t next_nonce = 0;
+  PresignaturePool pool(4, 2, 1, [&]() { return nonces.at(next_nonce++); });
+  WaitForDepth(pool, 4);
+
+  const auto private_key = ValueType::RandomBigInt(&prng);
+  const auto public_key = GetPublicKey(private_key);
+  for (size_t i = 0; i < 3; ++i) {
+    const auto z = PrimeFieldElement::FromUint(prng.RandomUint64());
+    const Signature sig = pool.Sign(private_key, z);
+    EXPECT_EQ(sig, SignEcdsa(private_key, z, nonces[i]));
+    EXPECT_TRUE(VerifyEcdsa(public_key, z, sig));
+  }
+  EXPECT_ASSERT(pool.Sign(private_key, PrimeFieldElement::Zero()), HasSubstr("cannot be zero"));
+
+  // The depth dropped below the low watermark, so the pool is refilled.
+  WaitForDepth(pool, 4);
+  const PresignaturePool::Stats stats = pool.GetStats();
+  EXPECT_EQ(stats.n_generated, 7U);
+  EXPECT_EQ(stats.n_consumed, 3U);
+  EXPECT_EQ(stats.n_empty_pops, 0U);
+}
+
+TEST(PresignaturePool, EmptyPool) {
+  // With a low watermark of zero, the pool is filled only once.
+  PresignaturePool pool(1, 0);
+  WaitForDepth(pool, 1);
+  const auto private_key = 0x3c1e9550e66958296d11b60f8e8e7a7ad990d07fa65d5f7652c4a6c87d4e3cc_Z;
+  const auto z = PrimeFieldElement::FromUint(1234);
+  for (size_t i = 0; i < 2; ++i) {
+    EXPECT_TRUE(VerifyEcdsa(GetPublicKey(private_key), z, pool.Sign(private_key, z)));
+  }
+  const PresignaturePool::Stats stats = pool.GetStats();
+  EXPECT_EQ(stats.depth, 0U);
+  EXPECT_EQ(stats.n_generated, 2U);
+  EXPECT_EQ(stats.n_consumed, 1U);
+  EXPECT_EQ(stats.n_empty_pops, 1U);
+}
+
+TEST(PresignaturePool, NonceSourceErrors) {
+  Prng prng;
+  std::atomic<size_t> n_calls{0};
+  PresignaturePool pool(2, 0, 1, [&]() {
+    ASSERT(n_calls++ > 0, "No randomness.");
+    return ValueType::RandomBigInt(&prng);
+  });
+  while (pool.GetStats().n_errors == 0) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  // The pool is not refilled until the error is thrown.
+  EXPECT_EQ(pool.GetStats().depth, 0U);
+  const auto private_key = ValueType::RandomBigInt(&prng);
+  const auto z = PrimeFieldElement::FromUint(1234);
+  EXPECT_ASSERT(pool.Sign(private_key, z), HasSubstr("No randomness"));
+  WaitForDepth(pool, 2);
+  EXPECT_TRUE(VerifyEcdsa(GetPublicKey(private_key), z, pool.Sign(private_key, z)));
+  EXPECT_EQ(pool.GetStats().n_errors, 1U);
+}
+
+TEST(PresignaturePool, InvertsNonces) {
+  PresignaturePool pool(PresignaturePool::kGenerationBatchSize, 0);
+  const auto& curve_order = GetEcConstants().k_order;
+  for (size_t i = 0; i < PresignaturePool::kGenerationBatchSize + 1; ++i) {
+    const PresignaturePool::Presignature presignature = pool.Pop();
+    EXPECT_EQ(
+        ValueType::MulMod(presignature.k, presignature.k_inv, curve_order), ValueType::One());
+  }
+}
+
+TEST(PresignaturePool, SecureRandomNonce) {
+  const ValueType nonce = PresignaturePool::SecureRandomNonce();
+  EXPECT_NE(nonce, ValueType::Zero());
+  EXPECT_LT(nonce, GetEcConstants().k_order);
+  EXPECT_NE(nonce, PresignaturePool::SecureRandomNonce());
+}
+
+TEST(PresignaturePool, InvalidParameters) {
+  EXPECT_ASSERT(PresignaturePool(0, 0), HasSubstr("capacity"));
+  EXPECT_ASSERT(PresignaturePool(2, 3), HasSubstr("watermark"));
+  EXPECT_ASSERT(PresignaturePool(2, 1, 0), HasSubstr("thread"));
+}
+
+}  // namespace
+}  // namespace starkware
@@ -0,0 +1,144 @@
+#include "starkware/crypto/rfc6979.h"
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include "starkware/crypto/elliptic_curve_constants.h"
+#include "starkware/crypto/sha256.h"
+
+namespace starkware {
+
+namespace {
+
+using ValueType = PrimeFieldElement::ValueType;
+
+/*
+  Returns the big-endian encoding of value, of length n_bytes (which must be large enough).
+*/
+template <size_t N>
+std::vector<uint8_t> ToBigEndian(const BigInt<N>& value, size_t n_bytes) {
+  std::vector<uint8_t> bytes(n_bytes);
+  for (size_t i = 0; i < n_bytes; ++i) {
+    const size_t byte_index = n_bytes - 1 - i;
+    const uint64_t limb = value[gsl::narrow_cast<int>(byte_index / 8)];
+    bytes[i] = static_cast<uint8_t>(limb >> (8 * (byte_index % 8)));
+  }
+  return bytes;
+}
+
+/*
+  Returns the number of bits in the binary representation of value.
+*/
+template <size_t N>
+size_t BitLength(const BigInt<N>& value) {
+  return BigInt<N>::kDigits - value.NumLeadingZeros();
+}
+
+/*
+  The deterministic random bit generator of RFC 6979, section 3.2.
+*/
+class HmacDrbg {
+ public:
+  HmacDrbg(
+      gsl::span<const uint8_t> private_key, gsl::span<const uint8_t> msg_hash,
+      gsl::span<const uint8_t> extra_entropy) {
+    v_.fill(0x01);
+    k_.fill(0x00);
+    Reseed(0x00, private_key, msg_hash, extra_entropy);
+    Reseed(0x01, private_key, msg_hash, extra_entropy);
+  }
+
+  /*
+    Returns the next block of output.
+  */
+  Sha256::Digest Generate() {
+    v_ = HmacSha256::Mac(k_, v_);
+    return v_;
+  }
+
+  /*
+    Updates the state after an output was rejected.
+  */
+  void Reject() {
+    HmacSha256 hmac(k_);
+    hmac.Update(v_);
+    hmac.Update(std::array<uint8_t, 1>{0x00});
+    k_ = hmac.Finalize();
+    v_ = HmacSha256::Mac(k_, v_);
+  }
+
+ private:
+  void Reseed(
+      uint8_t separator, gsl::span<const uint8_t> private_key, gsl::span<const uint8_t> msg_hash,
+      gsl::span<const uint8_t> extra_entropy) {
+    HmacSha256 hmac(k_);
+    hmac.Update(v_);
+    hmac.Update(std::array<uint8_t, 1>{separator});
+    hmac.Update(private_key);
+    hmac.Update(msg_hash);
+    hmac.Update(extra_entropy);
+    k_ = hmac.Finalize();
+    v_ = HmacSha256::Mac(k_, v_);
+  }
+
+  Sha256::Digest v_{};
+  Sha256::Digest k_{};
+};
+
+}  // namespace
+
+ValueType GenerateKRfc6979(
+    const ValueType& msg_hash, const ValueType& private_key, std::optional<uint64_t> seed) {
+  using WideValueType = BigInt<ValueType::LimbCount() + 1>;
+  const auto& curve_order = GetEcConstants().k_order;
+  const size_t order_bits = BitLength(curve_order);
+  const size_t order_bytes = (order_bits + 7) / 8;
+
+  // The message hash is encoded in its minimal number of bytes, after the shift for elliptic.js
+  // compatibility.
+  WideValueType msg = msg_hash;
+  const size_t msg_hash_bits = BitLength(msg_hash);
+  if (msg_hash_bits >= 248 && msg_hash_bits % 8 >= 1 && msg_hash_bits % 8 <= 4) {
+    for (size_t i = 0; i < 4; ++i) {
+      msg = msg + msg;
+    }
+  }
+  const size_t msg_bytes = (BitLength(msg) + 7) / 8;
+  // bits2octets(): keep the leftmost bits of the order's length, and reduce modulo the order.
+  if (8 * msg_bytes > order_bits) {
+    msg = msg.Div(WideValueType(uint64_t{1} << (8 * msg_bytes - order_bits))).first;
+  }
+  ValueType reduced_msg = ValueType::Zero();
+  for (size_t i = 0; i < ValueType::LimbCount(); ++i) {
+    reduced_msg[gsl::narrow_cast<int>(i)] = msg[gsl::narrow_cast<int>(i)];
+  }
+  if (reduced_msg >= curve_order) {
+    reduced_msg = reduced_msg - curve_order;
+  }
+
+  std::vector<uint8_t> extra_entropy;
+  if (seed.has_value()) {
+    extra_entropy = ToBigEndian(ValueType(*seed), (BitLength(ValueType(*seed)) + 7) / 8);
+  }
+
+  HmacDrbg drbg(
+      ToBigEndian(private_key, order_bytes), ToBigEndian(reduced_msg, order_bytes),
+      extra_entropy);
+  while (true) {
+    // bits2int() of a single block, which is as long as the order.
+    const Sha256::Digest block = drbg.Generate();
+    ValueType k = ValueType::Zero();
+    for (size_t i = 0; i < block.size(); ++i) {
+      const size_t byte_index = block.size() - 1 - i;
+      k[gsl::narrow_cast<int>(byte_index / 8)] |= uint64_t{block[i]} << (8 * (byte_index % 8));
+    }
+    k = k.Div(ValueType(uint64_t{1} << (8 * block.size() - order_bits))).first;
+    if (k != ValueType::Zero() && k < curve_order) {
+      return k;
+    }
+    drbg.Reject();
+  }
+}
+
+}  // namespace starkware
@@ -0,0 +1,26 @@
+#ifndef STARKWARE_CRYPTO_RFC6979_H_
+#define STARKWARE_CRYPTO_RFC6979_H_
+
+#include <cstdint>
+#include <optional>
+
+#include "starkware/algebra/prime_field_element.h"
+
+namespace starkware {
+
+/*
+  Deterministically generates the nonce k for an ECDSA signature of msg_hash with private_key on the
+  STARK curve, as in RFC 6979 with HMAC-SHA-256 (https://tools.ietf.org/html/rfc6979). If seed is
+  given, its minimal big-endian encoding is used as extra entropy.
+
+  This is compatible with generate_k_rfc6979() of StarkWare's Python library (which is in turn
+  compatible with elliptic.js): a message hash that is one nibble short of a multiple of 8 bits is
+  shifted by 4 bits first. Returns a number in the range [1, curve order).
+*/
+PrimeFieldElement::ValueType GenerateKRfc6979(
+    const PrimeFieldElement::ValueType& msg_hash, const PrimeFieldElement::ValueType& private_key,
+    std::optional<uint64_t> seed = std::nullopt);
+
+}  // namespace starkware
+
+#endif  // STARKWARE_CRYPTO_RFC6979_H_
@@ -0,0 +1,85 @@
+#include "starkware/crypto/rfc6979.h"
+
+#include <optional>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "starkware/crypto/ecdsa.h"
+#include "starkware/utils/test_utils.h"
+
+namespace starkware {
+namespace {
+
+using testing::HasSubstr;
+using ValueType = PrimeFieldElement::ValueType;
+
+/*
+  Test vectors computed with generate_k_rfc6979() and sign() of StarkWare's Python library.
+*/
+struct TestVector {
+  ValueType msg_hash;
+  ValueType private_key;
+  std::optional<uint64_t> seed;
+  ValueType k;
+  ValueType r;
+  ValueType w;
+};
+
+const std::vector<TestVector>& GetTestVectors() {
+  static const std::vector<TestVector> kTestVectors = {
+      {0x1_Z, 0x1_Z, std::nullopt,
+       0x2a3e2067f05114b62c785475a65b6c4a698b55f8707de4d3fe4cdd6238691ff_Z,
+       0xedf3922fdf0c1b98a861a38874120a437e33c08841923317aeb8ec6bad1400_Z,
+       0x7330eb6e3c5c7cf66c87b8eaeb27646457ef650a22fc281834ddfb52c7df0b8_Z},
+      {0x2_Z, 0x3c1e9550e66958296d11b60f8e8e7a7ad990d07fa65d5f7652c4a6c87d4e3cc_Z, std::nullopt,
+       0x7717ba6a96d629411313d2a33015d8d966e0af2a95d43a219b261af08ded0c3_Z,
+       0x3f8852c3010ca93d70ff7590903d4d140f04b17b41d7f7f360ddbe7118ff8ac_Z,
+       0x577a4fbab0f0a441901a1b8468f021b3219c7ca78ad60f2a560289d4b79bc69_Z},
+      // The signature of the VerifyEcdsa.Regression test in ecdsa_test.cc.
+      {0x397e76d1667c4454bfb83514e120583af836f8e32a516765497823eabe16a3f_Z,
+       0x3c1e9550e66958296d11b60f8e8e7a7ad990d07fa65d5f7652c4a6c87d4e3cc_Z, std::nullopt,
+       0x50a50e20a9fb5b33f618ce4ddec8df60f40d3ac3018453bcc002cee71140cd4_Z,
+       0x173fd03d8b008ee7432977ac27d1e9d1a1f6c98b1a2f05fa84a21c84c44e882_Z,
+       0x1f2c44a7798f55192f153b4c48ea5c1241fbb69e6132cc8a0da9c5b62a4286e_Z},
+      {0x7a8e5c1f6d3b2a1908f7e6d5c4b3a29180706f5e4d3c2b1a09f8e7d6c5b4a3_Z, 0x12345_Z, 7,
+       0xb91842f21d154ab35880171abffd3b4722d4dac3c3f35db32e07a10fbd6f1c_Z,
+       0x711611a29132e9038133a0bcc10e0620560ea480f0e79dcf39767b9ad96c6b_Z,
+       0x316da981efeb5f650447f3f1331c7094b3946672c0ac32406b719d23ee91038_Z},
+      {0xc0ffee_Z, 0x2dccce1da22003777062ee0870e9881b460a8b7eca276870f57c601f182136c_Z, 255,
+       0x376097711fa9074db341f55315434a3af6cfe0d13f504d3c10ba1b384d5922f_Z,
+       0x360925f8593c7151ca116dee46d3b675bf7b2795b7a123d90552f625a0ebd6f_Z,
+       0x5edf0394e98d4d96d1c84ba834c7b37e51e52062e8d76ca9950fa8216af6a59_Z},
+      // A 251-bit message hash, which is shifted for elliptic.js compatibility.
+      {0x6b2e8f0c4d1a3b5e7f9081726354a5b6c7d8e9f0a1b2c3d4e5f60718293a4b5_Z, 0x1234567_Z,
+       std::nullopt, 0x3ac2bbcf0e2ad980e2c40cbc490539dc44d2a05d92159249786f301f85f120b_Z,
+       0x748dae82386da514cf094a30c4504657f40b7faa3161f651e4a1fc2b4e2d153_Z,
+       0x221e73b23431e4d01ed9a6967cb26c20bc8d03abac03c8fab3fd5062bd1fae4_Z},
+  };
+  return kTestVectors;
+}
+
+TEST(Rfc6979, GenerateK) {
+  for (const TestVector& test_vector : GetTestVectors()) {
+    EXPECT_EQ(
+        GenerateKRfc6979(test_vector.msg_hash, test_vector.private_key, test_vector.seed),
+        test_vector.k);
+  }
+}
+
+TEST(Rfc6979, SignEcdsaDeterministic) {
+  for (const TestVector& test_vector : GetTestVectors()) {
+    const auto z = PrimeFieldElement::FromBigInt(test_vector.msg_hash);
+    const Signature sig =
+        SignEcdsaDeterministic(test_vector.private_key, z, test_vector.seed);
+    EXPECT_EQ(sig.first.ToStandardForm(), test_vector.r);
+    EXPECT_EQ(sig.second.ToStandardForm(), test_vector.w);
+    EXPECT_EQ(sig, SignEcdsa(test_vector.private_key, z, test_vector.k));
+  }
+  EXPECT_ASSERT(
+      SignEcdsaDeterministic(0x1_Z, PrimeFieldElement::Zero()), HasSubstr("cannot be zero"));
+}
+
+}  // namespace
+}  // namespace starkware
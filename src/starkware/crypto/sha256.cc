@@ -0,0 +1,147 @@
+#include "starkware/crypto/sha256.h"
+
+#include <algorithm>
+
+namespace starkware {
+
+namespace {
+
+constexpr std::array<uint32_t, 64> kRoundConstants = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+
+constexpr std::array<uint32_t, 8> kInitialState = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                                                   0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+
+constexpr uint32_t RotateRight(uint32_t x, unsigned n) { return (x >> n) | (x << (32 - n)); }
+
+}  // namespace
+
+Sha256::Sha256() : state_(kInitialState) {}
+
+void Sha256::ProcessBlock(const uint8_t* block) {
+  std::array<uint32_t, 64> w{};
+  for (size_t i = 0; i < 16; ++i) {
+    w[i] = (uint32_t{block[4 * i]} << 24) | (uint32_t{block[4 * i + 1]} << 16) |
+           (uint32_t{block[4 * i + 2]} << 8) | uint32_t{block[4 * i + 3]};
+  }
+  for (size_t i = 16; i < 64; ++i) {
+    const uint32_t s0 = RotateRight(w[i - 15], 7) ^ RotateRight(w[i - 15], 18) ^ (w[i - 15] >> 3);
+    const uint32_t s1 = RotateRight(w[i - 2], 17) ^ RotateRight(w[i - 2], 19) ^ (w[i - 2] >> 10);
+    w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+  }
+
+  auto [a, b, c, d, e, f, g, h] = state_;
+  for (size_t i = 0; i < 64; ++i) {
+    const uint32_t s1 = RotateRight(e, 6) ^ RotateRight(e, 11) ^ RotateRight(e, 25);
+    const uint32_t choice = (e & f) ^ (~e & g);
+    const uint32_t temp1 = h + s1 + choice + kRoundConstants[i] + w[i];
+    const uint32_t s0 = RotateRight(a, 2) ^ RotateRight(a, 13) ^ RotateRight(a, 22);
+    const uint32_t majority = (a & b) ^ (a & c) ^ (b & c);
+    const uint32_t temp2 = s0 + majority;
+    h = g;
+    g = f;
+    f = e;
+    e = d + temp1;
+    d = c;
+    c = b;
+    b = a;
+    a = temp1 + temp2;
+  }
+  state_[0] += a;
+  state_[1] += b;
+  state_[2] += c;
+  state_[3] += d;
+  state_[4] += e;
+  state_[5] += f;
+  state_[6] += g;
+  state_[7] += h;
+}
+
+void Sha256::Update(gsl::span<const uint8_t> data) {
+  message_size_ += data.size();
+  size_t pos = 0;
+  if (buffer_size_ > 0) {
+    const size_t n_copied = std::min(kBlockSize - buffer_size_, data.size());
+    std::copy_n(data.data(), n_copied, buffer_.data() + buffer_size_);
+    buffer_size_ += n_copied;
+    pos = n_copied;
+    if (buffer_size_ < kBlockSize) {
+      return;
+    }
+    ProcessBlock(buffer_.data());
+    buffer_size_ = 0;
+  }
+  for (; pos + kBlockSize <= data.size(); pos += kBlockSize) {
+    ProcessBlock(data.data() + pos);
+  }
+  std::copy(data.data() + pos, data.data() + data.size(), buffer_.data());
+  buffer_size_ = data.size() - pos;
+}
+
+auto Sha256::Finalize() -> Digest {
+  const uint64_t message_bits = message_size_ * 8;
+  // Pad with 0x80, followed by zeros up to 8 bytes before the end of a block, followed by the
+  // message size in bits.
+  std::array<uint8_t, kBlockSize + 8> padding{};
+  padding[0] = 0x80;
+  const size_t n_zeros = (kBlockSize + kBlockSize - 8 - 1 - buffer_size_) % kBlockSize;
+  for (size_t i = 0; i < 8; ++i) {
+    padding[1 + n_zeros + i] = static_cast<uint8_t>(message_bits >> (56 - 8 * i));
+  }
+  Update(gsl::make_span(padding.data(), 1 + n_zeros + 8));
+
+  Digest digest{};
+  for (size_t i = 0; i < state_.size(); ++i) {
+    for (size_t j = 0; j < 4; ++j) {
+      digest[4 * i + j] = static_cast<uint8_t>(state_[i] >> (24 - 8 * j));
+    }
+  }
+  return digest;
+}
+
+auto Sha256::Hash(gsl::span<const uint8_t> data) -> Digest {
+  Sha256 hash;
+  hash.Update(data);
+  return hash.Finalize();
+}
+
+HmacSha256::HmacSha256(gsl::span<const uint8_t> key) {
+  // Keys longer than a block are hashed, and shorter ones are padded with zeros.
+  std::array<uint8_t, Sha256::kBlockSize> block_key{};
+  if (key.size() > Sha256::kBlockSize) {
+    const Sha256::Digest key_hash = Sha256::Hash(key);
+    std::copy(key_hash.begin(), key_hash.end(), block_key.begin());
+  } else {
+    std::copy(key.begin(), key.end(), block_key.begin());
+  }
+
+  std::array<uint8_t, Sha256::kBlockSize> padded_key{};
+  for (size_t i = 0; i < Sha256::kBlockSize; ++i) {
+    padded_key[i] = block_key[i] ^ 0x36;
+  }
+  inner_.Update(padded_key);
+  for (size_t i = 0; i < Sha256::kBlockSize; ++i) {
+    padded_key[i] = block_key[i] ^ 0x5c;
+  }
+  outer_.Update(padded_key);
+}
+
+Sha256::Digest HmacSha256::Finalize() {
+  outer_.Update(inner_.Finalize());
+  return outer_.Finalize();
+}
+
+Sha256::Digest HmacSha256::Mac(gsl::span<const uint8_t> key, gsl::span<const uint8_t> data) {
+  HmacSha256 hmac(key);
+  hmac.Update(data);
+  return hmac.Finalize();
+}
+
+}  // namespace starkware
@@ -0,0 +1,73 @@
+#ifndef STARKWARE_CRYPTO_SHA256_H_
+#define STARKWARE_CRYPTO_SHA256_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "third_party/gsl/gsl-lite.hpp"
+
+namespace starkware {
+
+/*
+  An incremental SHA-256 hash (FIPS 180-4).
+*/
+class Sha256 {
+ public:
+  static constexpr size_t kDigestSize = 32;
+  static constexpr size_t kBlockSize = 64;
+  using Digest = std::array<uint8_t, kDigestSize>;
+
+  Sha256();
+
+  /*
+    Appends data to the hashed message.
+  */
+  void Update(gsl::span<const uint8_t> data);
+
+  /*
+    Returns the hash of the message. The object must not be used afterwards.
+  */
+  Digest Finalize();
+
+  /*
+    Returns the hash of data.
+  */
+  static Digest Hash(gsl::span<const uint8_t> data);
+
+ private:
+  void ProcessBlock(const uint8_t* block);
+
+  std::array<uint32_t, 8> state_;
+  std::array<uint8_t, kBlockSize> buffer_{};
+  size_t buffer_size_ = 0;
+  uint64_t message_size_ = 0;
+};
+
+/*
+  An incremental HMAC-SHA-256 (RFC 2104).
+*/
+class HmacSha256 {
+ public:
+  explicit HmacSha256(gsl::span<const uint8_t> key);
+
+  void Update(gsl::span<const uint8_t> data) { inner_.Update(data); }
+
+  /*
+    Returns the HMAC of the message. The object must not be used afterwards.
+  */
+  Sha256::Digest Finalize();
+
+  /*
+    Returns the HMAC of data with key.
+  */
+  static Sha256::Digest Mac(gsl::span<const uint8_t> key, gsl::span<const uint8_t> data);
+
+ private:
+  Sha256 inner_;
+  Sha256 outer_;
+};
+
+}  // namespace starkware
+
+#endif  // STARKWARE_CRYPTO_SHA256_H_
@@ -0,0 +1,70 @@
+#include "starkware/crypto/sha256.h"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace starkware {
+namespace {
+
+std::string ToHex(const Sha256::Digest& digest) {
+  std::string res;
+  for (uint8_t byte : digest) {
+    char buffer[3];
+    snprintf(buffer, sizeof(buffer), "%02x", byte);
+    res += buffer;
+  }
+  return res;
+}
+
+gsl::span<const uint8_t> AsBytes(const std::string& str) {
+  return gsl::make_span(reinterpret_cast<const uint8_t*>(str.data()), str.size());
+}
+
+TEST(Sha256, TestVectors) {
+  EXPECT_EQ(
+      ToHex(Sha256::Hash(AsBytes(""))),
+      "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+  EXPECT_EQ(
+      ToHex(Sha256::Hash(AsBytes("abc"))),
+      "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+  // A message whose padding does not fit in its last block.
+  EXPECT_EQ(
+      ToHex(Sha256::Hash(AsBytes("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq"))),
+      "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+}
+
+TEST(Sha256, Incremental) {
+  std::vector<uint8_t> data;
+  for (size_t i = 0; i < 3 * 256; ++i) {
+    data.push_back(static_cast<uint8_t>(i));
+  }
+  const std::string expected = "f3a25aa93aa2fbba28d79260535bbd6a5eb0fc1c24a8b0f04e12b484c1dfe363";
+  EXPECT_EQ(ToHex(Sha256::Hash(data)), expected);
+
+  for (size_t part_size : {1, 7, 64, 100}) {
+    Sha256 hash;
+    for (size_t i = 0; i < data.size(); i += part_size) {
+      hash.Update(gsl::make_span(data).subspan(i, std::min(part_size, data.size() - i)));
+    }
+    EXPECT_EQ(ToHex(hash.Finalize()), expected);
+  }
+}
+
+TEST(HmacSha256, TestVectors) {
+  // Test cases 1 and 6 of RFC 4231.
+  const std::vector<uint8_t> short_key(20, 0x0b);
+  EXPECT_EQ(
+      ToHex(HmacSha256::Mac(short_key, AsBytes("Hi There"))),
+      "b0344c61d8db38535ca8afceaf0bf12b881dc200c9833da726e9376c2e32cff7");
+  const std::vector<uint8_t> long_key(131, 0xaa);
+  EXPECT_EQ(
+      ToHex(HmacSha256::Mac(
+          long_key, AsBytes("Test Using Larger Than Block-Size Key - Hash Key First"))),
+      "60e431591ee0b67f0d8a26aacbf5b77f8e0bc6213728c5140546040f0ee37f54");
+}
+
+}  // namespace
+}  // namespace starkware
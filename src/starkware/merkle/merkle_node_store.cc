@@ -0,0 +1,23 @@
+#include "starkware/merkle/merkle_node_store.h"
+
+namespace starkware {
+
+std::optional<PrimeFieldElement> InMemoryMerkleNodeStore::Get(uint64_t node_index) const {
+  const PrimeFieldElement* value = nodes_.Find(node_index);
+  if (value == nullptr) {
+    return std::nullopt;
+  }
+  return *value;
+}
+
+void InMemoryMerkleNodeStore::Write(gsl::span<const NodeWrite> writes) {
+  for (const auto& [node_index, value] : writes) {
+    if (value.has_value()) {
+      nodes_.Set(node_index, *value);
+    } else {
+      nodes_.Erase(node_index);
+    }
+  }
+}
+
+}  // namespace starkware
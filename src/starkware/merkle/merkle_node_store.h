@@ -0,0 +1,65 @@
+#ifndef STARKWARE_MERKLE_MERKLE_NODE_STORE_H_
+#define STARKWARE_MERKLE_MERKLE_NODE_STORE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <utility>
+
+#include "third_party/gsl/gsl-lite.hpp"
+
+#include "starkware/algebra/prime_field_element.h"
+#include "starkware/merkle/node_map.h"
+
+namespace starkware {
+
+/*
+  Stores the non-default nodes of a SparseMerkleTree, by node index.
+*/
+class MerkleNodeStore {
+ public:
+  /*
+    A write of a single node, given as (node_index, value). A value of nullopt resets the node to
+    its default value (i.e., removes it from the store).
+  */
+  using NodeWrite = std::pair<uint64_t, std::optional<PrimeFieldElement>>;
+
+  virtual ~MerkleNodeStore() = default;
+
+  /*
+    Returns the value of the given node, or nullopt if the node is not stored.
+    Concurrent calls to Get() are safe as long as no Write() runs at the same time.
+  */
+  virtual std::optional<PrimeFieldElement> Get(uint64_t node_index) const = 0;
+
+  /*
+    Applies all the given writes. Persistent stores apply them atomically: if the process crashes,
+    the store is later found either in the state before the call or in the state after it.
+    The node indices in writes must be distinct.
+  */
+  virtual void Write(gsl::span<const NodeWrite> writes) = 0;
+
+  /*
+    Returns the number of stored nodes.
+  */
+  virtual size_t NumStoredNodes() const = 0;
+};
+
+/*
+  A MerkleNodeStore that keeps the nodes in memory.
+*/
+class InMemoryMerkleNodeStore : public MerkleNodeStore {
+ public:
+  std::optional<PrimeFieldElement> Get(uint64_t node_index) const override;
+
+  void Write(gsl::span<const NodeWrite> writes) override;
+
+  size_t NumStoredNodes() const override { return nodes_.Size(); }
+
+ private:
+  NodeMap nodes_;
+};
+
+}  // namespace starkware
+
+#endif  // STARKWARE_MERKLE_MERKLE_NODE_STORE_H_
@@ -0,0 +1,132 @@
+#include "starkware/merkle/merkle_proof.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "starkware/crypto/pedersen_hash.h"
+#include "starkware/utils/error_handling.h"
+#include "starkware/utils/math.h"
+
+namespace starkware {
+
+namespace {
+
+// Verifying a proof takes one hash per level, so a few proofs are enough work for a thread (see
+// SparseMerkleTree::kMinHashesPerThread).
+constexpr size_t kMinProofsPerThread = 4;
+
+/*
+  Verifies proofs[begin, end) and writes the results to results[begin, end).
+*/
+void VerifyMerkleProofsRange(
+    gsl::span<const MerkleProof> proofs, const PrimeFieldElement& root, size_t begin, size_t end,
+    std::vector<uint8_t>* results) {
+  // The proofs that are still being verified, and the current node on the path of each of them.
+  std::vector<size_t> active;
+  std::vector<PrimeFieldElement> nodes;
+  for (size_t i = begin; i < end; ++i) {
+    const MerkleProof& proof = proofs[i];
+    if (proof.path.size() > SparseMerkleTree::kMaxHeight ||
+        proof.leaf_index >= Pow2(proof.path.size())) {
+      (*results)[i] = 0;
+      continue;
+    }
+    active.push_back(i);
+    nodes.push_back(proof.leaf);
+  }
+
+  std::vector<PrimeFieldElement> left_children;
+  std::vector<PrimeFieldElement> right_children;
+  for (size_t level = 0; !active.empty(); ++level) {
+    // Compare the proofs that reached their root, and remove them.
+    size_t n_active = 0;
+    for (size_t j = 0; j < active.size(); ++j) {
+      const MerkleProof& proof = proofs[active[j]];
+      if (proof.path.size() == level) {
+        (*results)[active[j]] = nodes[j] == root ? 1 : 0;
+        continue;
+      }
+      active[n_active] = active[j];
+      nodes[n_active] = nodes[j];
+      n_active++;
+    }
+    active.resize(n_active);
+    nodes.resize(n_active, PrimeFieldElement::Zero());
+
+    // Compute the next node on every remaining path, in a single batch.
+    left_children.clear();
+    right_children.clear();
+    for (size_t j = 0; j < active.size(); ++j) {
+      const MerkleProof& proof = proofs[active[j]];
+      const bool is_right_child = ((proof.leaf_index >> level) & 1) != 0;
+      left_children.push_back(is_right_child ? proof.path[level] : nodes[j]);
+      right_children.push_back(is_right_child ? nodes[j] : proof.path[level]);
+    }
+    PedersenHashBatch(left_children, right_children, nodes);
+  }
+}
+
+}  // namespace
+
+std::vector<MerkleProof> GenerateMerkleProofs(
+    const SparseMerkleTree& tree, gsl::span<const uint64_t> leaf_indices) {
+  const size_t height = tree.Height();
+  for (const uint64_t leaf_index : leaf_indices) {
+    ASSERT(leaf_index < Pow2(height), "Leaf index is out of range.");
+  }
+
+  // nodes holds the distinct ancestors of the requested leaves at the current level, in increasing
+  // order. parent_positions[level][i] is the position of the parent of the i-th of them in the list
+  // of the next level, and siblings[level][i] is the value of its sibling.
+  std::vector<uint64_t> nodes(leaf_indices.begin(), leaf_indices.end());
+  std::sort(nodes.begin(), nodes.end());
+  nodes.erase(std::unique(nodes.begin(), nodes.end()), nodes.end());
+  std::vector<uint64_t> leaves = nodes;
+
+  std::vector<std::vector<size_t>> parent_positions(height);
+  std::vector<std::vector<PrimeFieldElement>> siblings(height);
+  std::vector<uint64_t> parents;
+  for (size_t level = 0; level < height; ++level) {
+    parents.clear();
+    siblings[level].reserve(nodes.size());
+    parent_positions[level].reserve(nodes.size());
+    for (const uint64_t node : nodes) {
+      const uint64_t node_index = Pow2(height - level) + node;
+      siblings[level].push_back(tree.GetNode(node_index ^ 1));
+      if (parents.empty() || parents.back() != node / 2) {
+        parents.push_back(node / 2);
+      }
+      parent_positions[level].push_back(parents.size() - 1);
+    }
+    std::swap(nodes, parents);
+  }
+
+  std::vector<MerkleProof> proofs;
+  proofs.reserve(leaf_indices.size());
+  for (const uint64_t leaf_index : leaf_indices) {
+    MerkleProof proof{leaf_index, tree.GetLeaf(leaf_index), {}};
+    proof.path.reserve(height);
+    size_t position = std::lower_bound(leaves.begin(), leaves.end(), leaf_index) - leaves.begin();
+    for (size_t level = 0; level < height; ++level) {
+      proof.path.push_back(siblings[level][position]);
+      position = parent_positions[level][position];
+    }
+    proofs.push_back(std::move(proof));
+  }
+  return proofs;
+}
+
+std::vector<bool> VerifyMerkleProofs(
+    gsl::span<const MerkleProof> proofs, const PrimeFieldElement& root, size_t n_threads) {
+  // Every thread writes to a separate range of results, so it cannot be a vector<bool>.
+  std::vector<uint8_t> results(proofs.size());
+  ParallelFor(
+      proofs.size(), n_threads,
+      [&proofs, &root, &results](size_t begin, size_t end) {
+        VerifyMerkleProofsRange(proofs, root, begin, end, &results);
+      },
+      kMinProofsPerThread);
+  return std::vector<bool>(results.begin(), results.end());
+}
+
+}  // namespace starkware
@@ -0,0 +1,48 @@
+#ifndef STARKWARE_MERKLE_MERKLE_PROOF_H_
+#define STARKWARE_MERKLE_MERKLE_PROOF_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "third_party/gsl/gsl-lite.hpp"
+
+#include "starkware/algebra/prime_field_element.h"
+#include "starkware/merkle/sparse_merkle_tree.h"
+#include "starkware/utils/parallel.h"
+
+namespace starkware {
+
+/*
+  An authentication path of a leaf in a Merkle tree of height path.size(). path[i] is the sibling of
+  the ancestor of the leaf at level i, so path[0] is the sibling of the leaf itself.
+*/
+struct MerkleProof {
+  uint64_t leaf_index;
+  PrimeFieldElement leaf;
+  std::vector<PrimeFieldElement> path;
+};
+
+/*
+  Returns the proofs of the given leaves of tree, in the same order.
+  Every node that appears in more than one proof (as happens near the root, where the paths merge)
+  is read from the tree only once.
+*/
+std::vector<MerkleProof> GenerateMerkleProofs(
+    const SparseMerkleTree& tree, gsl::span<const uint64_t> leaf_indices);
+
+/*
+  Returns, for every proof, whether it shows that its leaf is in a tree with the given root.
+  A proof whose leaf_index is out of range for its height is rejected.
+
+  Proofs of the same height are verified level by level, so the hashes of all the proofs at a given
+  level are computed together using PedersenHashBatch() (sharing a single field inversion). The
+  proofs are split among n_threads threads.
+*/
+std::vector<bool> VerifyMerkleProofs(
+    gsl::span<const MerkleProof> proofs, const PrimeFieldElement& root,
+    size_t n_threads = GetNumHardwareThreads());
+
+}  // namespace starkware
+
+#endif  // STARKWARE_MERKLE_MERKLE_PROOF_H_
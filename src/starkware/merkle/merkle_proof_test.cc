@@ -0,0 +1,106 @@
+#include "starkware/merkle/merkle_proof.h"
+
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "starkware/crypto/pedersen_hash.h"
+#include "starkware/utils/math.h"
+#include "starkware/utils/prng.h"
+#include "starkware/utils/test_utils.h"
+
+namespace starkware {
+namespace {
+
+using testing::ElementsAreArray;
+using testing::HasSubstr;
+using LeafUpdate = SparseMerkleTree::LeafUpdate;
+
+constexpr size_t kHeight = 8;
+
+/*
+  Returns a tree whose leaves are all random, so that a proof cannot be valid for a different leaf.
+*/
+SparseMerkleTree RandomTree(Prng* prng) {
+  SparseMerkleTree tree(kHeight);
+  std::vector<LeafUpdate> updates;
+  for (uint64_t leaf_index = 0; leaf_index < Pow2(kHeight); ++leaf_index) {
+    updates.emplace_back(leaf_index, PrimeFieldElement::RandomElement(prng));
+  }
+  tree.UpdateLeaves(updates);
+  return tree;
+}
+
+/*
+  Verifies a single proof with sequential calls to PedersenHash().
+*/
+bool NaiveVerify(const MerkleProof& proof, const PrimeFieldElement& root) {
+  PrimeFieldElement node = proof.leaf;
+  for (size_t level = 0; level < proof.path.size(); ++level) {
+    node = ((proof.leaf_index >> level) & 1) != 0 ? PedersenHash(proof.path[level], node)
+                                                   : PedersenHash(node, proof.path[level]);
+  }
+  return node == root;
+}
+
+TEST(MerkleProof, GenerateAndVerify) {
+  Prng prng;
+  const SparseMerkleTree tree = RandomTree(&prng);
+
+  // Includes a repeated leaf and adjacent leaves, whose paths overlap.
+  const std::vector<uint64_t> leaf_indices = {0, 1, 17, 200, 17, Pow2(kHeight) - 1, 128};
+  const std::vector<MerkleProof> proofs = GenerateMerkleProofs(tree, leaf_indices);
+  ASSERT_EQ(proofs.size(), leaf_indices.size());
+  for (size_t i = 0; i < proofs.size(); ++i) {
+    const MerkleProof& proof = proofs[i];
+    EXPECT_EQ(proof.leaf_index, leaf_indices[i]);
+    EXPECT_EQ(proof.leaf, tree.GetLeaf(leaf_indices[i]));
+    ASSERT_EQ(proof.path.size(), kHeight);
+    EXPECT_EQ(proof.path[0], tree.GetLeaf(leaf_indices[i] ^ 1));
+    EXPECT_EQ(proof.path[kHeight - 1], tree.GetNode(2 + ((leaf_indices[i] >> (kHeight - 1)) ^ 1)));
+    EXPECT_TRUE(NaiveVerify(proof, tree.GetRoot()));
+  }
+
+  const std::vector<bool> expected(proofs.size(), true);
+  EXPECT_THAT(VerifyMerkleProofs(proofs, tree.GetRoot(), 1), ElementsAreArray(expected));
+  EXPECT_THAT(VerifyMerkleProofs(proofs, tree.GetRoot(), 3), ElementsAreArray(expected));
+  EXPECT_TRUE(GenerateMerkleProofs(tree, {}).empty());
+}
+
+TEST(MerkleProof, InvalidProofs) {
+  Prng prng;
+  const SparseMerkleTree tree = RandomTree(&prng);
+  const std::vector<uint64_t> leaf_indices = {3, 4, 5, 6, 7, 8};
+  std::vector<MerkleProof> proofs = GenerateMerkleProofs(tree, leaf_indices);
+
+  proofs[0].leaf = proofs[0].leaf + PrimeFieldElement::One();
+  proofs[1].path[3] = proofs[1].path[3] + PrimeFieldElement::One();
+  proofs[2].leaf_index ^= 2;
+  proofs[3].leaf_index = Pow2(kHeight);
+  proofs[4].path.pop_back();
+  const std::vector<bool> results = VerifyMerkleProofs(proofs, tree.GetRoot());
+  EXPECT_THAT(results, ElementsAreArray({false, false, false, false, false, true}));
+  for (size_t i = 0; i < proofs.size(); ++i) {
+    EXPECT_EQ(results[i], NaiveVerify(proofs[i], tree.GetRoot()));
+  }
+
+  EXPECT_FALSE(VerifyMerkleProofs(proofs, PrimeFieldElement::Zero())[5]);
+  EXPECT_ASSERT(
+      GenerateMerkleProofs(tree, std::vector<uint64_t>{Pow2(kHeight)}), HasSubstr("out of range"));
+}
+
+TEST(MerkleProof, MixedHeights) {
+  Prng prng;
+  const SparseMerkleTree tree = RandomTree(&prng);
+  // A proof of the subtree rooted at node 2 is a proof for a tree of height kHeight - 1.
+  MerkleProof short_proof = GenerateMerkleProofs(tree, std::vector<uint64_t>{5})[0];
+  short_proof.path.pop_back();
+  const std::vector<MerkleProof> proofs = {
+      short_proof, GenerateMerkleProofs(tree, std::vector<uint64_t>{5})[0]};
+  EXPECT_THAT(VerifyMerkleProofs(proofs, tree.GetNode(2)), ElementsAreArray({true, false}));
+  EXPECT_THAT(VerifyMerkleProofs(proofs, tree.GetRoot()), ElementsAreArray({false, true}));
+}
+
+}  // namespace
+}  // namespace starkware
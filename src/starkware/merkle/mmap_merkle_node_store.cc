@@ -0,0 +1,290 @@
+#include "starkware/merkle/mmap_merkle_node_store.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "starkware/utils/error_handling.h"
+#include "starkware/utils/math.h"
+#include "starkware/utils/portable_endian.h"
+
+namespace starkware {
+
+namespace {
+
+using ValueType = PrimeFieldElement::ValueType;
+
+// The file of a tree of height h is 2^(h+6) bytes, so larger trees do not fit in the address space.
+constexpr size_t kMaxHeight = 40;
+
+constexpr uint64_t kFileMagic = 0x45455254454b5753;     // "SWKETREE" in little-endian.
+constexpr uint64_t kJournalMagic = 0x4c4e524a454b5753;  // "SWKEJRNL" in little-endian.
+constexpr uint64_t kVersion = 2;
+constexpr uint64_t kStoredFlag = Pow2(63);
+
+// The header of the file and of the journal are sequences of little-endian uint64 fields. The
+// default leaf takes one field per limb of its standard form, starting at kDefaultLeaf.
+enum FileHeaderField : size_t {
+  kMagic,
+  kVersionField,
+  kHeight,
+  kGeneration,
+  kNStoredNodes,
+  kDefaultLeaf
+};
+enum JournalHeaderField : size_t {
+  kJournalMagicField,
+  kJournalGeneration,
+  kJournalNRecords,
+  kJournalNStoredNodes,
+  kJournalChecksum,
+  kNJournalHeaderFields
+};
+
+constexpr size_t kJournalHeaderSize = kNJournalHeaderFields * sizeof(uint64_t);
+// A journal record is the node index followed by the new record of the node.
+constexpr size_t kJournalRecordSize = sizeof(uint64_t) + MmapMerkleNodeStore::kRecordSize;
+
+uint64_t LoadField(const gsl::byte* base, size_t field) {
+  uint64_t value;
+  memcpy(&value, base + field * sizeof(uint64_t), sizeof(uint64_t));
+  return le64toh(value);
+}
+
+void StoreField(gsl::byte* base, size_t field, uint64_t value) {
+  value = htole64(value);
+  memcpy(base + field * sizeof(uint64_t), &value, sizeof(uint64_t));
+}
+
+void EncodeRecord(const std::optional<PrimeFieldElement>& value, gsl::byte* record) {
+  if (!value.has_value()) {
+    memset(record, 0, MmapMerkleNodeStore::kRecordSize);
+    return;
+  }
+  ValueType standard_form = value->ToStandardForm();
+  standard_form[ValueType::LimbCount() - 1] |= kStoredFlag;
+  standard_form.ToLittleEndian(gsl::make_span(record, MmapMerkleNodeStore::kRecordSize));
+}
+
+bool IsStored(const gsl::byte* record) {
+  return (LoadField(record, ValueType::LimbCount() - 1) & kStoredFlag) != 0;
+}
+
+std::optional<PrimeFieldElement> DecodeRecord(const gsl::byte* record) {
+  if (!IsStored(record)) {
+    return std::nullopt;
+  }
+  ValueType value =
+      ValueType::FromLittleEndian(gsl::make_span(record, MmapMerkleNodeStore::kRecordSize));
+  value[ValueType::LimbCount() - 1] &= ~kStoredFlag;
+  return PrimeFieldElement::FromBigInt(value);
+}
+
+/*
+  FNV-1a hash, used to detect a journal that was not completely written.
+*/
+uint64_t Checksum(gsl::span<const gsl::byte> data) {
+  uint64_t hash = 0xcbf29ce484222325;
+  for (const gsl::byte b : data) {
+    hash = (hash ^ gsl::to_integer<uint64_t>(b)) * 0x100000001b3;
+  }
+  return hash;
+}
+
+std::string SystemError(const std::string& operation, const std::string& path) {
+  return operation + " failed for " + path + ": " + strerror(errno);
+}
+
+void SyncFile(int fd, const std::string& path) {
+  ASSERT(fdatasync(fd) == 0, SystemError("fdatasync", path));
+}
+
+}  // namespace
+
+MmapMerkleNodeStore::MmapMerkleNodeStore(
+    const std::string& path, size_t height, const PrimeFieldElement& default_leaf)
+    : path_(path), height_(height) {
+  ASSERT(height_ <= kMaxHeight, "Tree height is too big for a memory-mapped store.");
+  try {
+    fd_ = open(path_.c_str(), O_RDWR | O_CREAT, 0644);
+    ASSERT(fd_ >= 0, SystemError("open", path_));
+    // Node indices are in the range [1, 2^(height+1)).
+    mapped_size_ = kHeaderSize + (Pow2(height_ + 1) * kRecordSize);
+
+    struct stat file_stat {};
+    ASSERT(fstat(fd_, &file_stat) == 0, SystemError("fstat", path_));
+    if (file_stat.st_size == 0) {
+      ASSERT(ftruncate(fd_, mapped_size_) == 0, SystemError("ftruncate", path_));
+    } else {
+      ASSERT(
+          static_cast<size_t>(file_stat.st_size) == mapped_size_,
+          "The size of " + path_ + " does not match a tree of height " + std::to_string(height_) +
+              ".");
+    }
+
+    void* data = mmap(nullptr, mapped_size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    ASSERT(data != MAP_FAILED, SystemError("mmap", path_));
+    data_ = static_cast<gsl::byte*>(data);
+
+    // The header is initialized before any node is written, so a zero magic means that the store
+    // was never used (e.g., the process crashed while creating it).
+    const ValueType default_leaf_value = default_leaf.ToStandardForm();
+    if (LoadField(data_, kMagic) == 0) {
+      StoreField(data_, kVersionField, kVersion);
+      StoreField(data_, kHeight, height_);
+      for (size_t i = 0; i < ValueType::LimbCount(); ++i) {
+        StoreField(data_, kDefaultLeaf + i, default_leaf_value[i]);
+      }
+      StoreField(data_, kMagic, kFileMagic);
+      CommitHeader();
+    } else {
+      ASSERT(LoadField(data_, kMagic) == kFileMagic, path_ + " is not a Merkle node store.");
+      ASSERT(
+          LoadField(data_, kVersionField) == kVersion, "Unsupported Merkle node store version.");
+      ASSERT(
+          LoadField(data_, kHeight) == height_,
+          "The tree height of " + path_ + " is not " + std::to_string(height_) + ".");
+      ValueType stored_default_leaf = ValueType::Zero();
+      for (size_t i = 0; i < ValueType::LimbCount(); ++i) {
+        stored_default_leaf[i] = LoadField(data_, kDefaultLeaf + i);
+      }
+      ASSERT(
+          stored_default_leaf == default_leaf_value,
+          "The default leaf of " + path_ + " is not " + default_leaf.ToString() + ".");
+      generation_ = LoadField(data_, kGeneration);
+      n_stored_nodes_ = LoadField(data_, kNStoredNodes);
+    }
+
+    const std::string journal_path = path_ + ".journal";
+    journal_fd_ = open(journal_path.c_str(), O_RDWR | O_CREAT, 0644);
+    ASSERT(journal_fd_ >= 0, SystemError("open", journal_path));
+    RecoverFromJournal();
+  } catch (...) {
+    Close();
+    throw;
+  }
+}
+
+MmapMerkleNodeStore::~MmapMerkleNodeStore() { Close(); }
+
+void MmapMerkleNodeStore::Close() {
+  if (data_ != nullptr) {
+    munmap(data_, mapped_size_);
+    data_ = nullptr;
+  }
+  if (fd_ >= 0) {
+    close(fd_);
+    fd_ = -1;
+  }
+  if (journal_fd_ >= 0) {
+    close(journal_fd_);
+    journal_fd_ = -1;
+  }
+}
+
+gsl::span<gsl::byte> MmapMerkleNodeStore::Record(uint64_t node_index) const {
+  ASSERT(node_index != 0 && node_index < Pow2(height_ + 1), "Node index is out of range.");
+  return gsl::make_span(data_ + kHeaderSize + node_index * kRecordSize, kRecordSize);
+}
+
+std::optional<PrimeFieldElement> MmapMerkleNodeStore::Get(uint64_t node_index) const {
+  return DecodeRecord(Record(node_index).data());
+}
+
+void MmapMerkleNodeStore::Write(gsl::span<const NodeWrite> writes) {
+  std::vector<gsl::byte> journal(kJournalHeaderSize + writes.size() * kJournalRecordSize);
+  uint64_t n_stored_nodes = n_stored_nodes_;
+  for (size_t i = 0; i < writes.size(); ++i) {
+    const auto& [node_index, value] = writes[i];
+    const bool was_stored = IsStored(Record(node_index).data());
+    if (value.has_value() && !was_stored) {
+      n_stored_nodes++;
+    } else if (!value.has_value() && was_stored) {
+      n_stored_nodes--;
+    }
+    gsl::byte* journal_record = journal.data() + kJournalHeaderSize + i * kJournalRecordSize;
+    StoreField(journal_record, 0, node_index);
+    EncodeRecord(value, journal_record + sizeof(uint64_t));
+  }
+  StoreField(journal.data(), kJournalMagicField, kJournalMagic);
+  StoreField(journal.data(), kJournalGeneration, generation_ + 1);
+  StoreField(journal.data(), kJournalNRecords, writes.size());
+  StoreField(journal.data(), kJournalNStoredNodes, n_stored_nodes);
+  StoreField(journal.data(), kJournalChecksum, Checksum(journal));
+
+  // Make the batch durable before any record is modified in place.
+  const std::string journal_path = path_ + ".journal";
+  size_t written = 0;
+  while (written < journal.size()) {
+    const ssize_t res =
+        pwrite(journal_fd_, journal.data() + written, journal.size() - written, written);
+    ASSERT(res > 0, SystemError("pwrite", journal_path));
+    written += res;
+  }
+  ASSERT(ftruncate(journal_fd_, journal.size()) == 0, SystemError("ftruncate", journal_path));
+  SyncFile(journal_fd_, journal_path);
+
+  ApplyJournalRecords(gsl::make_span(journal).subspan(kJournalHeaderSize));
+  generation_++;
+  n_stored_nodes_ = n_stored_nodes;
+  CommitHeader();
+}
+
+void MmapMerkleNodeStore::ApplyJournalRecords(gsl::span<const gsl::byte> journal_records) {
+  for (size_t offset = 0; offset < journal_records.size(); offset += kJournalRecordSize) {
+    const gsl::byte* journal_record = journal_records.data() + offset;
+    memcpy(
+        Record(LoadField(journal_record, 0)).data(), journal_record + sizeof(uint64_t),
+        kRecordSize);
+  }
+}
+
+void MmapMerkleNodeStore::CommitHeader() {
+  // The records must reach the disk before the header that refers to them.
+  SyncFile(fd_, path_);
+  StoreField(data_, kGeneration, generation_);
+  StoreField(data_, kNStoredNodes, n_stored_nodes_);
+  SyncFile(fd_, path_);
+}
+
+void MmapMerkleNodeStore::RecoverFromJournal() {
+  const std::string journal_path = path_ + ".journal";
+  struct stat journal_stat {};
+  ASSERT(fstat(journal_fd_, &journal_stat) == 0, SystemError("fstat", journal_path));
+  const auto journal_size = static_cast<size_t>(journal_stat.st_size);
+  if (journal_size < kJournalHeaderSize) {
+    return;
+  }
+
+  std::vector<gsl::byte> journal(journal_size);
+  ASSERT(
+      pread(journal_fd_, journal.data(), journal_size, 0) == static_cast<ssize_t>(journal_size),
+      SystemError("pread", journal_path));
+  // A journal of an older generation was already applied. A journal of the next generation is
+  // replayed only if it was completely written (otherwise, no record was modified).
+  const uint64_t n_records = LoadField(journal.data(), kJournalNRecords);
+  if (LoadField(journal.data(), kJournalMagicField) != kJournalMagic ||
+      LoadField(journal.data(), kJournalGeneration) != generation_ + 1 ||
+      n_records > (journal_size - kJournalHeaderSize) / kJournalRecordSize) {
+    return;
+  }
+  journal.resize(kJournalHeaderSize + n_records * kJournalRecordSize);
+  const uint64_t checksum = LoadField(journal.data(), kJournalChecksum);
+  StoreField(journal.data(), kJournalChecksum, 0);
+  if (Checksum(journal) != checksum) {
+    return;
+  }
+
+  ApplyJournalRecords(gsl::make_span(journal).subspan(kJournalHeaderSize));
+  generation_++;
+  n_stored_nodes_ = LoadField(journal.data(), kJournalNStoredNodes);
+  CommitHeader();
+}
+
+}  // namespace starkware
@@ -0,0 +1,101 @@
+#ifndef STARKWARE_MERKLE_MMAP_MERKLE_NODE_STORE_H_
+#define STARKWARE_MERKLE_MMAP_MERKLE_NODE_STORE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+#include "third_party/gsl/gsl-lite.hpp"
+
+#include "starkware/algebra/prime_field_element.h"
+#include "starkware/merkle/merkle_node_store.h"
+
+namespace starkware {
+
+/*
+  A MerkleNodeStore backed by a memory-mapped file. A tree over an existing store is available
+  immediately after the store is opened (no hash is recomputed), and nodes are paged in from disk
+  only when they are accessed.
+
+  File layout: a header page, followed by a fixed-size record for every node index of a tree of the
+  given height; node i is at offset kHeaderSize + i * kRecordSize. A record is the 32-byte
+  little-endian encoding of the node value (the encoding of Serialize() in ffi/utils.h), with the
+  most significant bit, which is never set in a field element, marking that the node is stored.
+  Records of nodes that were never stored are all zeros. The file is created sparse, so they take
+  no disk space.
+
+  Crash consistency: Write() first writes the entire batch to a journal file (path + ".journal")
+  and syncs it. Only then are the records modified in place, after which the generation in the
+  header is incremented. When a store is opened and its journal holds a complete batch for the next
+  generation, the batch is replayed. Hence, after a crash the store is found either before or
+  after the last Write(), and the root is always consistent with the leaves.
+*/
+class MmapMerkleNodeStore : public MerkleNodeStore {
+ public:
+  static constexpr size_t kHeaderSize = 4096;
+  static constexpr size_t kRecordSize = 32;
+
+  /*
+    Opens the store at path, creating it if it does not exist. height and default_leaf must be those
+    of the tree the store was created for, which are recorded in its header: the nodes that are not
+    stored are only meaningful with the same default leaf.
+  */
+  MmapMerkleNodeStore(
+      const std::string& path, size_t height,
+      const PrimeFieldElement& default_leaf = PrimeFieldElement::Zero());
+
+  ~MmapMerkleNodeStore() override;
+
+  MmapMerkleNodeStore(const MmapMerkleNodeStore&) = delete;
+  MmapMerkleNodeStore& operator=(const MmapMerkleNodeStore&) = delete;
+  MmapMerkleNodeStore(MmapMerkleNodeStore&&) = delete;
+  MmapMerkleNodeStore& operator=(MmapMerkleNodeStore&&) = delete;
+
+  std::optional<PrimeFieldElement> Get(uint64_t node_index) const override;
+
+  void Write(gsl::span<const NodeWrite> writes) override;
+
+  size_t NumStoredNodes() const override { return n_stored_nodes_; }
+
+  /*
+    Returns the number of batches written to the store since it was created.
+  */
+  uint64_t Generation() const { return generation_; }
+
+ private:
+  /*
+    Returns the record of node_index in the mapped file.
+  */
+  gsl::span<gsl::byte> Record(uint64_t node_index) const;
+
+  /*
+    Copies the (node_index, record) pairs in journal_records to the mapped file.
+  */
+  void ApplyJournalRecords(gsl::span<const gsl::byte> journal_records);
+
+  /*
+    Writes generation_ and n_stored_nodes_ to the header and syncs the file.
+  */
+  void CommitHeader();
+
+  /*
+    Replays the journal if it holds a complete batch of the next generation.
+  */
+  void RecoverFromJournal();
+
+  void Close();
+
+  const std::string path_;
+  const size_t height_;
+  int fd_ = -1;
+  int journal_fd_ = -1;
+  gsl::byte* data_ = nullptr;
+  size_t mapped_size_ = 0;
+  uint64_t generation_ = 0;
+  uint64_t n_stored_nodes_ = 0;
+};
+
+}  // namespace starkware
+
+#endif  // STARKWARE_MERKLE_MMAP_MERKLE_NODE_STORE_H_
@@ -0,0 +1,180 @@
+#include "starkware/merkle/mmap_merkle_node_store.h"
+
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "starkware/merkle/sparse_merkle_tree.h"
+#include "starkware/utils/math.h"
+#include "starkware/utils/prng.h"
+#include "starkware/utils/test_utils.h"
+
+namespace starkware {
+namespace {
+
+using testing::HasSubstr;
+using LeafUpdate = SparseMerkleTree::LeafUpdate;
+
+constexpr size_t kHeight = 10;
+
+class MmapMerkleNodeStoreTest : public ::testing::Test {
+ public:
+  MmapMerkleNodeStoreTest()
+      : path_(
+            ::testing::TempDir() + "mmap_merkle_node_store_" +
+            std::to_string(prng_.RandomUint64())) {}
+
+  ~MmapMerkleNodeStoreTest() override {
+    for (const std::string& path : {path_, CrashPath()}) {
+      std::remove(path.c_str());
+      std::remove((path + ".journal").c_str());
+    }
+  }
+
+ protected:
+  std::string CrashPath() const { return path_ + "_crash"; }
+
+  static void CopyFile(const std::string& from, const std::string& to) {
+    std::ifstream src(from, std::ios::binary);
+    std::ofstream dst(to, std::ios::binary | std::ios::trunc);
+    dst << src.rdbuf();
+  }
+
+  std::vector<LeafUpdate> RandomUpdates(size_t n_updates) {
+    std::vector<LeafUpdate> updates;
+    for (size_t i = 0; i < n_updates; ++i) {
+      updates.emplace_back(
+          prng_.RandomUint64(0, Pow2(kHeight) - 1), PrimeFieldElement::RandomElement(&prng_));
+    }
+    return updates;
+  }
+
+  SparseMerkleTree OpenTree(const std::string& path) {
+    return SparseMerkleTree(
+        kHeight, PrimeFieldElement::Zero(), 1,
+        std::make_unique<MmapMerkleNodeStore>(path, kHeight));
+  }
+
+  Prng prng_;
+  const std::string path_;
+};
+
+TEST_F(MmapMerkleNodeStoreTest, GetAndWrite) {
+  MmapMerkleNodeStore store(path_, kHeight);
+  const auto value = PrimeFieldElement::RandomElement(&prng_);
+  EXPECT_EQ(store.Get(5), std::nullopt);
+
+  const std::vector<MerkleNodeStore::NodeWrite> writes = {
+      {5, value}, {6, PrimeFieldElement::Zero()}, {7, std::nullopt}};
+  store.Write(writes);
+  EXPECT_EQ(store.Get(5), value);
+  EXPECT_EQ(store.Get(6), PrimeFieldElement::Zero());
+  EXPECT_EQ(store.Get(7), std::nullopt);
+  EXPECT_EQ(store.NumStoredNodes(), 2U);
+  EXPECT_EQ(store.Generation(), 1U);
+
+  const std::vector<MerkleNodeStore::NodeWrite> erase = {{5, std::nullopt}};
+  store.Write(erase);
+  EXPECT_EQ(store.Get(5), std::nullopt);
+  EXPECT_EQ(store.NumStoredNodes(), 1U);
+
+  EXPECT_ASSERT(store.Get(0), HasSubstr("out of range"));
+  EXPECT_ASSERT(store.Get(Pow2(kHeight + 1)), HasSubstr("out of range"));
+}
+
+TEST_F(MmapMerkleNodeStoreTest, Reopen) {
+  PrimeFieldElement root = PrimeFieldElement::Zero();
+  const std::vector<LeafUpdate> updates = RandomUpdates(20);
+  {
+    SparseMerkleTree tree = OpenTree(path_);
+    tree.UpdateLeaves(updates);
+    root = tree.GetRoot();
+  }
+
+  SparseMerkleTree reopened_tree = OpenTree(path_);
+  EXPECT_EQ(reopened_tree.GetRoot(), root);
+
+  // The reopened tree is identical to one that was built in memory.
+  SparseMerkleTree in_memory_tree(kHeight);
+  in_memory_tree.UpdateLeaves(updates);
+  EXPECT_EQ(reopened_tree.GetRoot(), in_memory_tree.GetRoot());
+  EXPECT_EQ(reopened_tree.NumStoredNodes(), in_memory_tree.NumStoredNodes());
+  for (const auto& update : updates) {
+    EXPECT_EQ(reopened_tree.GetLeaf(update.first), in_memory_tree.GetLeaf(update.first));
+  }
+}
+
+TEST_F(MmapMerkleNodeStoreTest, HeightMismatch) {
+  { MmapMerkleNodeStore store(path_, kHeight); }
+  EXPECT_ASSERT(MmapMerkleNodeStore(path_, kHeight + 1), HasSubstr("does not match"));
+}
+
+TEST_F(MmapMerkleNodeStoreTest, DefaultLeafMismatch) {
+  const auto default_leaf = PrimeFieldElement::FromUint(7);
+  const std::vector<LeafUpdate> updates = RandomUpdates(5);
+  PrimeFieldElement root = PrimeFieldElement::Zero();
+  {
+    SparseMerkleTree tree(
+        kHeight, default_leaf, 1,
+        std::make_unique<MmapMerkleNodeStore>(path_, kHeight, default_leaf));
+    tree.UpdateLeaves(updates);
+    root = tree.GetRoot();
+  }
+  EXPECT_ASSERT(MmapMerkleNodeStore(path_, kHeight), HasSubstr("default leaf"));
+
+  SparseMerkleTree reopened_tree(
+      kHeight, default_leaf, 1,
+      std::make_unique<MmapMerkleNodeStore>(path_, kHeight, default_leaf));
+  EXPECT_EQ(reopened_tree.GetRoot(), root);
+}
+
+TEST_F(MmapMerkleNodeStoreTest, CrashAfterJournalIsReplayed) {
+  SparseMerkleTree tree = OpenTree(path_);
+  tree.UpdateLeaves(RandomUpdates(5));
+  const PrimeFieldElement old_root = tree.GetRoot();
+
+  // Simulate a crash after the journal was synced and before any record was modified, by combining
+  // the file from before the write with the journal from after it.
+  CopyFile(path_, CrashPath());
+  tree.UpdateLeaves(RandomUpdates(5));
+  const PrimeFieldElement new_root = tree.GetRoot();
+  ASSERT_NE(new_root, old_root);
+  CopyFile(path_ + ".journal", CrashPath() + ".journal");
+
+  SparseMerkleTree recovered_tree = OpenTree(CrashPath());
+  EXPECT_EQ(recovered_tree.GetRoot(), new_root);
+  EXPECT_EQ(recovered_tree.NumStoredNodes(), tree.NumStoredNodes());
+}
+
+TEST_F(MmapMerkleNodeStoreTest, TornJournalIsIgnored) {
+  SparseMerkleTree tree = OpenTree(path_);
+  tree.UpdateLeaves(RandomUpdates(5));
+  const PrimeFieldElement old_root = tree.GetRoot();
+  const size_t old_n_stored_nodes = tree.NumStoredNodes();
+
+  CopyFile(path_, CrashPath());
+  tree.UpdateLeaves(RandomUpdates(5));
+  CopyFile(path_ + ".journal", CrashPath() + ".journal");
+
+  // Corrupt the last byte of the journal, as if the crash happened while it was written.
+  {
+    std::fstream journal(
+        CrashPath() + ".journal", std::ios::in | std::ios::out | std::ios::binary);
+    journal.seekg(-1, std::ios::end);
+    const char last_byte = static_cast<char>(journal.get() ^ 1);
+    journal.seekp(-1, std::ios::end);
+    journal.put(last_byte);
+  }
+
+  SparseMerkleTree recovered_tree = OpenTree(CrashPath());
+  EXPECT_EQ(recovered_tree.GetRoot(), old_root);
+  EXPECT_EQ(recovered_tree.NumStoredNodes(), old_n_stored_nodes);
+}
+
+}  // namespace
+}  // namespace starkware
@@ -0,0 +1,96 @@
+#include "starkware/merkle/node_map.h"
+
+#include <utility>
+
+#include "starkware/utils/error_handling.h"
+
+namespace starkware {
+
+namespace {
+
+// The map is kept at most half full, to keep the probe sequences short.
+constexpr size_t kMaxLoadFactorInverse = 2;
+constexpr size_t kInitialLogNSlots = 4;
+
+}  // namespace
+
+size_t NodeMap::HomeSlot(uint64_t node_index) const {
+  // Fibonacci hashing: the top bits of the product are well mixed even for sequential indices.
+  constexpr uint64_t kGoldenRatio = 0x9e3779b97f4a7c15;
+  return static_cast<size_t>((node_index * kGoldenRatio) >> (64 - log_n_slots_));
+}
+
+size_t NodeMap::FindSlot(uint64_t node_index) const {
+  const size_t mask = slots_.size() - 1;
+  size_t slot = HomeSlot(node_index);
+  while (slots_[slot].node_index != 0 && slots_[slot].node_index != node_index) {
+    slot = (slot + 1) & mask;
+  }
+  return slot;
+}
+
+const PrimeFieldElement* NodeMap::Find(uint64_t node_index) const {
+  if (slots_.empty()) {
+    return nullptr;
+  }
+  const Slot& slot = slots_[FindSlot(node_index)];
+  return slot.node_index == node_index ? &slot.value : nullptr;
+}
+
+void NodeMap::Set(uint64_t node_index, const PrimeFieldElement& value) {
+  ASSERT(node_index != 0, "0 is not a valid node index.");
+  if ((size_ + 1) * kMaxLoadFactorInverse > slots_.size()) {
+    Grow();
+  }
+  Slot& slot = slots_[FindSlot(node_index)];
+  if (slot.node_index == 0) {
+    slot.node_index = node_index;
+    size_++;
+  }
+  slot.value = value;
+}
+
+void NodeMap::Erase(uint64_t node_index) {
+  if (slots_.empty()) {
+    return;
+  }
+  const size_t mask = slots_.size() - 1;
+  size_t hole = FindSlot(node_index);
+  if (slots_[hole].node_index == 0) {
+    return;
+  }
+  size_--;
+
+  // Backward shift deletion: move back every following entry of the cluster whose probe sequence
+  // passes through the hole, so that no tombstones are needed.
+  for (size_t slot = (hole + 1) & mask; slots_[slot].node_index != 0; slot = (slot + 1) & mask) {
+    const size_t home = HomeSlot(slots_[slot].node_index);
+    // The entry can be moved to the hole iff home is not cyclically in (hole, slot].
+    const bool home_in_range =
+        hole <= slot ? (hole < home && home <= slot) : (hole < home || home <= slot);
+    if (!home_in_range) {
+      slots_[hole] = slots_[slot];
+      hole = slot;
+    }
+  }
+  slots_[hole].node_index = 0;
+}
+
+void NodeMap::Grow() {
+  std::vector<Slot> old_slots = std::move(slots_);
+  log_n_slots_ = old_slots.empty() ? kInitialLogNSlots : log_n_slots_ + 1;
+  slots_ = std::vector<Slot>(size_t{1} << log_n_slots_, Slot{0, PrimeFieldElement::Zero()});
+  const size_t mask = slots_.size() - 1;
+  for (const Slot& old_slot : old_slots) {
+    if (old_slot.node_index == 0) {
+      continue;
+    }
+    size_t slot = HomeSlot(old_slot.node_index);
+    while (slots_[slot].node_index != 0) {
+      slot = (slot + 1) & mask;
+    }
+    slots_[slot] = old_slot;
+  }
+}
+
+}  // namespace starkware
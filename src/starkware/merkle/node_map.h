@@ -0,0 +1,78 @@
+#ifndef STARKWARE_MERKLE_NODE_MAP_H_
+#define STARKWARE_MERKLE_NODE_MAP_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "starkware/algebra/prime_field_element.h"
+
+namespace starkware {
+
+/*
+  A hash map from node indices to field elements, stored in a single flat array using open
+  addressing with linear probing. Since 0 is never a valid node index (the root is 1), it is used to
+  mark empty slots.
+  Concurrent calls to Find() are safe as long as the map is not modified at the same time.
+*/
+class NodeMap {
+ public:
+  NodeMap() = default;
+
+  /*
+    Returns a pointer to the value stored for node_index, or nullptr if there is no such value. The
+    pointer is invalidated by the next call to Set() or Erase().
+  */
+  const PrimeFieldElement* Find(uint64_t node_index) const;
+
+  void Set(uint64_t node_index, const PrimeFieldElement& value);
+
+  /*
+    Removes node_index from the map, if present.
+  */
+  void Erase(uint64_t node_index);
+
+  size_t Size() const { return size_; }
+
+  /*
+    Calls func(node_index, value) for every entry in the map, in an unspecified order.
+  */
+  template <typename Func>
+  void ForEach(const Func& func) const {
+    for (const Slot& slot : slots_) {
+      if (slot.node_index != 0) {
+        func(slot.node_index, slot.value);
+      }
+    }
+  }
+
+ private:
+  struct Slot {
+    uint64_t node_index;
+    PrimeFieldElement value;
+  };
+
+  /*
+    Returns the slot in which the search for node_index starts.
+  */
+  size_t HomeSlot(uint64_t node_index) const;
+
+  /*
+    Returns the slot that holds node_index, or the empty slot where it should be inserted.
+  */
+  size_t FindSlot(uint64_t node_index) const;
+
+  /*
+    Doubles the number of slots and reinserts all the entries.
+  */
+  void Grow();
+
+  std::vector<Slot> slots_;
+  size_t size_ = 0;
+  // The number of slots is 2^log_n_slots_.
+  size_t log_n_slots_ = 0;
+};
+
+}  // namespace starkware
+
+#endif  // STARKWARE_MERKLE_NODE_MAP_H_
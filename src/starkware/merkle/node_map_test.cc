@@ -0,0 +1,60 @@
+#include "starkware/merkle/node_map.h"
+
+#include <map>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "starkware/utils/prng.h"
+#include "starkware/utils/test_utils.h"
+
+namespace starkware {
+namespace {
+
+TEST(NodeMap, Empty) {
+  NodeMap map;
+  EXPECT_EQ(map.Size(), 0U);
+  EXPECT_EQ(map.Find(1), nullptr);
+  map.Erase(1);
+  EXPECT_ASSERT(map.Set(0, PrimeFieldElement::One()), testing::HasSubstr("not a valid"));
+}
+
+TEST(NodeMap, Random) {
+  Prng prng;
+  NodeMap map;
+  std::map<uint64_t, PrimeFieldElement> expected;
+  for (size_t i = 0; i < 5000; ++i) {
+    // Use a small key range so that sets, overwrites and erases are all frequent.
+    const uint64_t node_index = prng.RandomUint64(1, 300);
+    if (prng.RandomUint64(0, 2) == 0) {
+      map.Erase(node_index);
+      expected.erase(node_index);
+    } else {
+      const auto value = PrimeFieldElement::FromUint(prng.RandomUint64());
+      map.Set(node_index, value);
+      expected.insert_or_assign(node_index, value);
+    }
+  }
+
+  ASSERT_EQ(map.Size(), expected.size());
+  for (uint64_t node_index = 1; node_index <= 300; ++node_index) {
+    const PrimeFieldElement* value = map.Find(node_index);
+    const auto it = expected.find(node_index);
+    if (it == expected.end()) {
+      EXPECT_EQ(value, nullptr);
+    } else {
+      ASSERT_NE(value, nullptr);
+      EXPECT_EQ(*value, it->second);
+    }
+  }
+
+  size_t n_entries = 0;
+  map.ForEach([&](uint64_t node_index, const PrimeFieldElement& value) {
+    EXPECT_EQ(expected.at(node_index), value);
+    n_entries++;
+  });
+  EXPECT_EQ(n_entries, expected.size());
+}
+
+}  // namespace
+}  // namespace starkware
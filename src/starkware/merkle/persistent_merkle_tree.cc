@@ -0,0 +1,191 @@
+#include "starkware/merkle/persistent_merkle_tree.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "starkware/crypto/pedersen_hash.h"
+#include "starkware/merkle/sparse_merkle_tree.h"
+#include "starkware/utils/error_handling.h"
+#include "starkware/utils/math.h"
+
+namespace starkware {
+
+/*
+  A node of the tree. A nullptr child stands for an empty subtree. value is only modified while the
+  node is created, before it is shared by a snapshot.
+*/
+struct PersistentMerkleTree::Node {
+  PrimeFieldElement value;
+  std::shared_ptr<const Node> left;
+  std::shared_ptr<const Node> right;
+};
+
+namespace {
+
+using Node = PersistentMerkleTree::Node;
+using LeafUpdate = PersistentMerkleTree::LeafUpdate;
+
+/*
+  Returns a copy of old_node (nullptr for an empty subtree) at the given level, in which the leaves
+  in updates are set. updates must be sorted by leaf index, without duplicates, and all in the
+  subtree of old_node. The value of the new nodes is not computed; instead, the new nodes of every
+  level are added to (*new_nodes)[level].
+*/
+std::shared_ptr<Node> CopyPath(
+    const Node* old_node, size_t level, gsl::span<const LeafUpdate> updates,
+    std::vector<std::vector<Node*>>* new_nodes) {
+  if (level == 0) {
+    return std::make_shared<Node>(Node{updates[0].second, nullptr, nullptr});
+  }
+
+  auto node = std::make_shared<Node>(Node{PrimeFieldElement::Zero(), nullptr, nullptr});
+  if (old_node != nullptr) {
+    node->left = old_node->left;
+    node->right = old_node->right;
+  }
+  const uint64_t right_bit = Pow2(level - 1);
+  const auto split = std::partition_point(
+      updates.begin(), updates.end(),
+      [right_bit](const LeafUpdate& update) { return (update.first & right_bit) == 0; });
+  const size_t n_left = split - updates.begin();
+  if (n_left > 0) {
+    node->left = CopyPath(node->left.get(), level - 1, updates.first(n_left), new_nodes);
+  }
+  if (n_left < updates.size()) {
+    node->right = CopyPath(node->right.get(), level - 1, updates.subspan(n_left), new_nodes);
+  }
+  (*new_nodes)[level].push_back(node.get());
+  return node;
+}
+
+}  // namespace
+
+PrimeFieldElement PersistentMerkleTree::Snapshot::GetRoot() const {
+  return root_ != nullptr ? root_->value : default_nodes_->back();
+}
+
+PrimeFieldElement PersistentMerkleTree::Snapshot::GetLeaf(uint64_t leaf_index) const {
+  ASSERT(leaf_index < Pow2(Height()), "Leaf index is out of range.");
+  const Node* node = root_.get();
+  for (size_t level = Height(); level > 0 && node != nullptr; --level) {
+    node = ((leaf_index >> (level - 1)) & 1) != 0 ? node->right.get() : node->left.get();
+  }
+  return node != nullptr ? node->value : (*default_nodes_)[0];
+}
+
+std::vector<MerkleProof> PersistentMerkleTree::Snapshot::GenerateProofs(
+    gsl::span<const uint64_t> leaf_indices) const {
+  const size_t height = Height();
+  std::vector<MerkleProof> proofs;
+  proofs.reserve(leaf_indices.size());
+  for (const uint64_t leaf_index : leaf_indices) {
+    ASSERT(leaf_index < Pow2(height), "Leaf index is out of range.");
+    MerkleProof proof{leaf_index, PrimeFieldElement::Zero(), {}};
+    proof.path.resize(height, PrimeFieldElement::Zero());
+    const Node* node = root_.get();
+    for (size_t level = height; level > 0; --level) {
+      const bool is_right = ((leaf_index >> (level - 1)) & 1) != 0;
+      const Node* sibling = nullptr;
+      if (node != nullptr) {
+        sibling = is_right ? node->left.get() : node->right.get();
+        node = is_right ? node->right.get() : node->left.get();
+      }
+      proof.path[level - 1] = sibling != nullptr ? sibling->value : (*default_nodes_)[level - 1];
+    }
+    proof.leaf = node != nullptr ? node->value : (*default_nodes_)[0];
+    proofs.push_back(std::move(proof));
+  }
+  return proofs;
+}
+
+PersistentMerkleTree::PersistentMerkleTree(
+    size_t height, const PrimeFieldElement& default_leaf, size_t max_versions, size_t n_threads)
+    : height_(SparseMerkleTree::ValidateHeight(height)),
+      max_versions_(std::max<size_t>(max_versions, 1)),
+      n_threads_(n_threads),
+      default_nodes_(std::make_shared<const std::vector<PrimeFieldElement>>(
+          ComputeDefaultNodes(height, default_leaf))),
+      history_(std::make_shared<const History>(
+          History{std::shared_ptr<const Snapshot>(new Snapshot(0, nullptr, default_nodes_))})) {}
+
+std::shared_ptr<const PersistentMerkleTree::Snapshot> PersistentMerkleTree::Head() const {
+  return std::atomic_load(&history_)->back();
+}
+
+std::shared_ptr<const PersistentMerkleTree::Snapshot> PersistentMerkleTree::GetSnapshot(
+    uint64_t version) const {
+  const std::shared_ptr<const History> history = std::atomic_load(&history_);
+  const uint64_t oldest_version = history->front()->Version();
+  if (version < oldest_version || version - oldest_version >= history->size()) {
+    return nullptr;
+  }
+  return (*history)[version - oldest_version];
+}
+
+std::shared_ptr<const PersistentMerkleTree::Snapshot> PersistentMerkleTree::UpdateLeaves(
+    gsl::span<const LeafUpdate> updates) {
+  const uint64_t n_leaves = Pow2(height_);
+  for (const auto& update : updates) {
+    ASSERT(update.first < n_leaves, "Leaf index is out of range.");
+  }
+
+  // Sort the updates by index, keeping the last update of every leaf.
+  std::vector<LeafUpdate> sorted_updates(updates.begin(), updates.end());
+  std::stable_sort(
+      sorted_updates.begin(), sorted_updates.end(),
+      [](const LeafUpdate& a, const LeafUpdate& b) { return a.first < b.first; });
+  std::vector<LeafUpdate> unique_updates;
+  unique_updates.reserve(sorted_updates.size());
+  for (size_t i = 0; i < sorted_updates.size(); ++i) {
+    if (i + 1 == sorted_updates.size() || sorted_updates[i + 1].first != sorted_updates[i].first) {
+      unique_updates.push_back(sorted_updates[i]);
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(update_mutex_);
+  const std::shared_ptr<const History> history = std::atomic_load(&history_);
+  const std::shared_ptr<const Snapshot>& head = history->back();
+  if (unique_updates.empty()) {
+    return head;
+  }
+
+  std::vector<std::vector<Node*>> new_nodes(height_ + 1);
+  const std::shared_ptr<const Node> root =
+      CopyPath(head->root_.get(), height_, unique_updates, &new_nodes);
+
+  // The children of the new nodes of a level are either new nodes of the previous level, whose
+  // values were already computed, or old nodes.
+  const std::vector<PrimeFieldElement>& default_nodes = *default_nodes_;
+  for (size_t level = 1; level <= height_; ++level) {
+    const std::vector<Node*>& nodes = new_nodes[level];
+    const PrimeFieldElement& default_child = default_nodes[level - 1];
+    ParallelFor(
+        nodes.size(), n_threads_,
+        [&nodes, &default_child](size_t begin, size_t end) {
+          std::vector<PrimeFieldElement> left_children;
+          std::vector<PrimeFieldElement> right_children;
+          std::vector<PrimeFieldElement> values(end - begin, PrimeFieldElement::Zero());
+          left_children.reserve(end - begin);
+          right_children.reserve(end - begin);
+          for (size_t i = begin; i < end; ++i) {
+            left_children.push_back(nodes[i]->left ? nodes[i]->left->value : default_child);
+            right_children.push_back(nodes[i]->right ? nodes[i]->right->value : default_child);
+          }
+          PedersenHashBatch(left_children, right_children, values);
+          for (size_t i = begin; i < end; ++i) {
+            nodes[i]->value = values[i - begin];
+          }
+        },
+        SparseMerkleTree::kMinHashesPerThread);
+  }
+
+  const std::shared_ptr<const Snapshot> snapshot(
+      new Snapshot(head->Version() + 1, root, default_nodes_));
+  auto new_history = std::make_shared<History>(
+      history->size() < max_versions_ ? history->begin() : history->begin() + 1, history->end());
+  new_history->push_back(snapshot);
+  std::atomic_store(&history_, std::shared_ptr<const History>(std::move(new_history)));
+  return snapshot;
+}
+
+}  // namespace starkware
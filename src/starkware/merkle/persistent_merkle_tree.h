@@ -0,0 +1,119 @@
+#ifndef STARKWARE_MERKLE_PERSISTENT_MERKLE_TREE_H_
+#define STARKWARE_MERKLE_PERSISTENT_MERKLE_TREE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "third_party/gsl/gsl-lite.hpp"
+
+#include "starkware/algebra/prime_field_element.h"
+#include "starkware/merkle/merkle_proof.h"
+#include "starkware/utils/parallel.h"
+
+namespace starkware {
+
+/*
+  A Merkle tree over PedersenHash (see SparseMerkleTree) that keeps its recent versions.
+
+  Every version is an immutable Snapshot. An update creates a new version, allocating only the nodes
+  on the paths from the updated leaves to the root; all the other nodes are shared with the previous
+  version. Empty subtrees are not allocated at all. Hence, keeping N versions costs one tree plus
+  the paths that changed between them, rather than N trees.
+
+  Snapshots are reference counted: a snapshot, and every node it uses, stays alive as long as a
+  reader holds it, even after it is evicted from the history of the tree.
+
+  Thread safety: readers (Head(), GetSnapshot() and all the methods of Snapshot) do not wait for a
+  concurrent UpdateLeaves() to finish. Head() and GetSnapshot() copy the current history with
+  std::atomic_load(), which is not lock-free (libstdc++ guards it with an internal mutex, held only
+  while the pointer is copied); the methods of Snapshot take no lock. Concurrent calls to
+  UpdateLeaves() are serialized.
+*/
+class PersistentMerkleTree {
+ public:
+  using LeafUpdate = std::pair<uint64_t, PrimeFieldElement>;
+
+  struct Node;
+
+  class Snapshot {
+   public:
+    uint64_t Version() const { return version_; }
+
+    size_t Height() const { return default_nodes_->size() - 1; }
+
+    PrimeFieldElement GetRoot() const;
+
+    PrimeFieldElement GetLeaf(uint64_t leaf_index) const;
+
+    /*
+      Returns the proofs of the given leaves against the root of this snapshot.
+    */
+    std::vector<MerkleProof> GenerateProofs(gsl::span<const uint64_t> leaf_indices) const;
+
+   private:
+    friend class PersistentMerkleTree;
+
+    Snapshot(
+        uint64_t version, std::shared_ptr<const Node> root,
+        std::shared_ptr<const std::vector<PrimeFieldElement>> default_nodes)
+        : version_(version), root_(std::move(root)), default_nodes_(std::move(default_nodes)) {}
+
+    const uint64_t version_;
+    // nullptr stands for an empty tree.
+    const std::shared_ptr<const Node> root_;
+    const std::shared_ptr<const std::vector<PrimeFieldElement>> default_nodes_;
+  };
+
+  /*
+    Creates a tree whose leaves are all default_leaf, as version 0. The last max_versions versions
+    (at least 1) are available through GetSnapshot(). n_threads is the maximal number of threads
+    used by UpdateLeaves().
+  */
+  explicit PersistentMerkleTree(
+      size_t height, const PrimeFieldElement& default_leaf = PrimeFieldElement::Zero(),
+      size_t max_versions = 16, size_t n_threads = GetNumHardwareThreads());
+
+  /*
+    Returns the latest version.
+  */
+  std::shared_ptr<const Snapshot> Head() const;
+
+  /*
+    Returns the given version, or nullptr if it was evicted from the history (or does not exist).
+  */
+  std::shared_ptr<const Snapshot> GetSnapshot(uint64_t version) const;
+
+  /*
+    Creates a new version, in which the given leaves of the latest version are set, and returns it.
+    If a leaf appears more than once, the last update wins. The hashes of every level are computed
+    together using PedersenHashBatch().
+  */
+  std::shared_ptr<const Snapshot> UpdateLeaves(gsl::span<const LeafUpdate> updates);
+
+ private:
+  using History = std::vector<std::shared_ptr<const Snapshot>>;
+
+  const size_t height_;
+  const size_t max_versions_;
+  const size_t n_threads_;
+  const std::shared_ptr<const std::vector<PrimeFieldElement>> default_nodes_;
+
+  // Serializes the writers.
+  std::mutex update_mutex_;
+
+  /*
+    The available versions, oldest first. The history is never modified in place: a writer replaces
+    it with a new one using std::atomic_store(), and readers copy it using std::atomic_load(). These
+    are the C++17 atomic operations on shared_ptr, which C++20 deprecates in favor of
+    std::atomic<std::shared_ptr>.
+  */
+  std::shared_ptr<const History> history_;
+};
+
+}  // namespace starkware
+
+#endif  // STARKWARE_MERKLE_PERSISTENT_MERKLE_TREE_H_
@@ -0,0 +1,115 @@
+#include "starkware/merkle/persistent_merkle_tree.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "starkware/merkle/sparse_merkle_tree.h"
+#include "starkware/utils/math.h"
+#include "starkware/utils/prng.h"
+#include "starkware/utils/test_utils.h"
+
+namespace starkware {
+namespace {
+
+using testing::HasSubstr;
+using LeafUpdate = PersistentMerkleTree::LeafUpdate;
+
+constexpr size_t kHeight = 6;
+
+std::vector<LeafUpdate> RandomUpdates(size_t n_updates, Prng* prng) {
+  std::vector<LeafUpdate> updates;
+  for (size_t i = 0; i < n_updates; ++i) {
+    updates.emplace_back(
+        prng->RandomUint64(0, Pow2(kHeight) - 1), PrimeFieldElement::RandomElement(prng));
+  }
+  return updates;
+}
+
+TEST(PersistentMerkleTree, CompareToSparseMerkleTree) {
+  Prng prng;
+  const auto default_leaf = PrimeFieldElement::RandomElement(&prng);
+  PersistentMerkleTree tree(kHeight, default_leaf, 3, 2);
+  SparseMerkleTree expected_tree(kHeight, default_leaf);
+  EXPECT_EQ(tree.Head()->Version(), 0U);
+  EXPECT_EQ(tree.Head()->GetRoot(), expected_tree.GetRoot());
+
+  std::vector<std::shared_ptr<const PersistentMerkleTree::Snapshot>> snapshots = {tree.Head()};
+  std::vector<PrimeFieldElement> roots = {expected_tree.GetRoot()};
+  for (size_t batch = 1; batch <= 5; ++batch) {
+    const std::vector<LeafUpdate> updates = RandomUpdates(8, &prng);
+    const auto snapshot = tree.UpdateLeaves(updates);
+    expected_tree.UpdateLeaves(updates);
+    EXPECT_EQ(snapshot->Version(), batch);
+    EXPECT_EQ(snapshot, tree.Head());
+    EXPECT_EQ(snapshot->GetRoot(), expected_tree.GetRoot());
+    for (const auto& update : updates) {
+      EXPECT_EQ(snapshot->GetLeaf(update.first), expected_tree.GetLeaf(update.first));
+    }
+    snapshots.push_back(snapshot);
+    roots.push_back(expected_tree.GetRoot());
+  }
+
+  // Old snapshots are not affected by later updates, even after they are evicted from the history.
+  for (size_t version = 0; version < snapshots.size(); ++version) {
+    EXPECT_EQ(snapshots[version]->GetRoot(), roots[version]);
+  }
+  EXPECT_EQ(tree.GetSnapshot(2), nullptr);
+  EXPECT_EQ(tree.GetSnapshot(3), snapshots[3]);
+  EXPECT_EQ(tree.GetSnapshot(5), snapshots[5]);
+  EXPECT_EQ(tree.GetSnapshot(6), nullptr);
+
+  // An empty update does not create a new version.
+  EXPECT_EQ(tree.UpdateLeaves({}), snapshots.back());
+}
+
+TEST(PersistentMerkleTree, ProofsOfOldVersions) {
+  Prng prng;
+  PersistentMerkleTree tree(kHeight);
+  const auto old_snapshot = tree.UpdateLeaves(RandomUpdates(10, &prng));
+  const auto new_snapshot = tree.UpdateLeaves(RandomUpdates(10, &prng));
+
+  const std::vector<uint64_t> leaf_indices = {0, 1, 7, 40, Pow2(kHeight) - 1};
+  for (const auto& snapshot : {old_snapshot, new_snapshot}) {
+    const std::vector<MerkleProof> proofs = snapshot->GenerateProofs(leaf_indices);
+    for (size_t i = 0; i < proofs.size(); ++i) {
+      EXPECT_EQ(proofs[i].leaf, snapshot->GetLeaf(leaf_indices[i]));
+    }
+    EXPECT_THAT(
+        VerifyMerkleProofs(proofs, snapshot->GetRoot()),
+        testing::ElementsAreArray(std::vector<bool>(leaf_indices.size(), true)));
+  }
+  EXPECT_ASSERT(
+      new_snapshot->GenerateProofs(std::vector<uint64_t>{Pow2(kHeight)}),
+      HasSubstr("out of range"));
+  EXPECT_ASSERT(
+      tree.UpdateLeaves(std::vector<LeafUpdate>{{Pow2(kHeight), PrimeFieldElement::Zero()}}),
+      HasSubstr("out of range"));
+}
+
+TEST(PersistentMerkleTree, ConcurrentReaders) {
+  Prng prng;
+  PersistentMerkleTree tree(kHeight, PrimeFieldElement::Zero(), 4, 1);
+  std::atomic<bool> done(false);
+  std::thread reader([&tree, &done]() {
+    while (!done) {
+      // A snapshot is consistent, regardless of concurrent updates.
+      const auto snapshot = tree.Head();
+      const std::vector<uint64_t> leaf_indices = {3};
+      const std::vector<MerkleProof> proofs = snapshot->GenerateProofs(leaf_indices);
+      ASSERT_TRUE(VerifyMerkleProofs(proofs, snapshot->GetRoot(), 1)[0]);
+    }
+  });
+  for (size_t i = 0; i < 10; ++i) {
+    tree.UpdateLeaves(RandomUpdates(4, &prng));
+  }
+  done = true;
+  reader.join();
+  EXPECT_EQ(tree.Head()->Version(), 10U);
+}
+
+}  // namespace
+}  // namespace starkware
@@ -0,0 +1,148 @@
+#include "starkware/merkle/sparse_merkle_tree.h"
+
+#include <algorithm>
+#include <optional>
+#include <utility>
+
+#include "starkware/crypto/pedersen_hash.h"
+#include "starkware/utils/error_handling.h"
+#include "starkware/utils/math.h"
+
+namespace starkware {
+
+std::vector<PrimeFieldElement> ComputeDefaultNodes(
+    size_t height, const PrimeFieldElement& default_leaf) {
+  std::vector<PrimeFieldElement> default_nodes;
+  default_nodes.reserve(height + 1);
+  default_nodes.push_back(default_leaf);
+  for (size_t level = 1; level <= height; ++level) {
+    default_nodes.push_back(PedersenHash(default_nodes.back(), default_nodes.back()));
+  }
+  return default_nodes;
+}
+
+size_t SparseMerkleTree::ValidateHeight(size_t height) {
+  ASSERT(height <= kMaxHeight, "Tree height is too big.");
+  return height;
+}
+
+SparseMerkleTree::SparseMerkleTree(
+    size_t height, const PrimeFieldElement& default_leaf, size_t n_threads,
+    std::unique_ptr<MerkleNodeStore> store)
+    : height_(ValidateHeight(height)),
+      n_threads_(n_threads),
+      default_nodes_(ComputeDefaultNodes(height, default_leaf)),
+      store_(store != nullptr ? std::move(store) : std::make_unique<InMemoryMerkleNodeStore>()) {}
+
+PrimeFieldElement SparseMerkleTree::GetLeaf(uint64_t leaf_index) const {
+  ASSERT(leaf_index < Pow2(height_), "Leaf index is out of range.");
+  return GetNode(Pow2(height_) + leaf_index);
+}
+
+PrimeFieldElement SparseMerkleTree::GetNode(uint64_t node_index) const {
+  const size_t level = NodeLevel(node_index);
+  const std::optional<PrimeFieldElement> value = store_->Get(node_index);
+  return value.has_value() ? *value : default_nodes_[level];
+}
+
+const PrimeFieldElement& SparseMerkleTree::GetDefaultNode(size_t level) const {
+  ASSERT(level <= height_, "Level is out of range.");
+  return default_nodes_[level];
+}
+
+size_t SparseMerkleTree::NodeLevel(uint64_t node_index) const {
+  ASSERT(node_index != 0, "0 is not a valid node index.");
+  const size_t depth = Log2Floor(node_index);
+  ASSERT(depth <= height_, "Node index is out of range.");
+  return height_ - depth;
+}
+
+void SparseMerkleTree::AddNodeWrites(
+    size_t level, gsl::span<const uint64_t> node_indices,
+    gsl::span<const PrimeFieldElement> values,
+    std::vector<MerkleNodeStore::NodeWrite>* writes) const {
+  for (size_t i = 0; i < node_indices.size(); ++i) {
+    if (values[i] == default_nodes_[level]) {
+      writes->emplace_back(node_indices[i], std::nullopt);
+    } else {
+      writes->emplace_back(node_indices[i], values[i]);
+    }
+  }
+}
+
+void SparseMerkleTree::UpdateLeaves(gsl::span<const LeafUpdate> updates) {
+  const uint64_t n_leaves = Pow2(height_);
+  for (const auto& update : updates) {
+    ASSERT(update.first < n_leaves, "Leaf index is out of range.");
+  }
+
+  // Sort the updates by index, keeping the last update of every leaf.
+  std::vector<LeafUpdate> sorted_updates(updates.begin(), updates.end());
+  std::stable_sort(
+      sorted_updates.begin(), sorted_updates.end(),
+      [](const LeafUpdate& a, const LeafUpdate& b) { return a.first < b.first; });
+
+  // The indices of the nodes of the current level that were modified, in increasing order, and
+  // their new values. These are not written to the store until all the levels are computed.
+  std::vector<uint64_t> dirty_nodes;
+  std::vector<PrimeFieldElement> dirty_values;
+  dirty_nodes.reserve(sorted_updates.size());
+  dirty_values.reserve(sorted_updates.size());
+  for (size_t i = 0; i < sorted_updates.size(); ++i) {
+    const auto& [leaf_index, value] = sorted_updates[i];
+    if (i + 1 < sorted_updates.size() && sorted_updates[i + 1].first == leaf_index) {
+      continue;
+    }
+    dirty_nodes.push_back(n_leaves + leaf_index);
+    dirty_values.push_back(value);
+  }
+
+  std::vector<MerkleNodeStore::NodeWrite> writes;
+  AddNodeWrites(0, dirty_nodes, dirty_values, &writes);
+
+  // Returns the value of a node of the previous level, which is either dirty or in the store.
+  auto get_child = [this, &dirty_nodes, &dirty_values](uint64_t node_index) {
+    const auto it = std::lower_bound(dirty_nodes.begin(), dirty_nodes.end(), node_index);
+    if (it != dirty_nodes.end() && *it == node_index) {
+      return dirty_values[it - dirty_nodes.begin()];
+    }
+    return GetNode(node_index);
+  };
+
+  std::vector<uint64_t> parents;
+  std::vector<PrimeFieldElement> values;
+  for (size_t level = 1; level <= height_; ++level) {
+    parents.clear();
+    for (const uint64_t node_index : dirty_nodes) {
+      if (parents.empty() || parents.back() != node_index / 2) {
+        parents.push_back(node_index / 2);
+      }
+    }
+
+    // All the hashes of a level are independent.
+    values.assign(parents.size(), PrimeFieldElement::Zero());
+    ParallelFor(
+        parents.size(), n_threads_,
+        [&parents, &values, &get_child](size_t begin, size_t end) {
+          std::vector<PrimeFieldElement> left_children;
+          std::vector<PrimeFieldElement> right_children;
+          left_children.reserve(end - begin);
+          right_children.reserve(end - begin);
+          for (size_t i = begin; i < end; ++i) {
+            left_children.push_back(get_child(2 * parents[i]));
+            right_children.push_back(get_child(2 * parents[i] + 1));
+          }
+          PedersenHashBatch(
+              left_children, right_children, gsl::make_span(values).subspan(begin, end - begin));
+        },
+        kMinHashesPerThread);
+
+    AddNodeWrites(level, parents, values, &writes);
+    std::swap(dirty_nodes, parents);
+    std::swap(dirty_values, values);
+  }
+
+  store_->Write(writes);
+}
+
+}  // namespace starkware
@@ -0,0 +1,120 @@
+#ifndef STARKWARE_MERKLE_SPARSE_MERKLE_TREE_H_
+#define STARKWARE_MERKLE_SPARSE_MERKLE_TREE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "third_party/gsl/gsl-lite.hpp"
+
+#include "starkware/algebra/prime_field_element.h"
+#include "starkware/merkle/merkle_node_store.h"
+#include "starkware/utils/parallel.h"
+
+namespace starkware {
+
+/*
+  Returns a vector v of size height + 1, where v[i] is the root of a Merkle tree of height i all of
+  whose leaves are default_leaf. A node of a Merkle tree is PedersenHash(left_child, right_child).
+*/
+std::vector<PrimeFieldElement> ComputeDefaultNodes(
+    size_t height, const PrimeFieldElement& default_leaf);
+
+/*
+  A Merkle tree over PedersenHash with 2^height leaves, most of which are expected to hold the
+  default leaf value (for example, the StarkEx vault tree of height 31).
+
+  Nodes are identified by their index in the standard heap order: the root is 1 and the children of
+  node i are 2*i and 2*i+1, so leaf j is node 2^height + j. The level of a node is its height above
+  the leaves (leaves are at level 0 and the root is at level height).
+
+  Only nodes whose value differs from the root of an empty subtree of the same level are stored, in
+  a MerkleNodeStore. The empty subtree roots are computed once, at construction.
+*/
+class SparseMerkleTree {
+ public:
+  /*
+    A new value for a leaf, given as (leaf_index, value).
+  */
+  using LeafUpdate = std::pair<uint64_t, PrimeFieldElement>;
+
+  static constexpr size_t kMaxHeight = 62;
+
+  /*
+    Below this number of hashes per thread, the cost of spawning a thread is not worth it. Used by
+    all the Merkle trees of this directory.
+  */
+  static constexpr size_t kMinHashesPerThread = 16;
+
+  /*
+    Returns height, after checking that it is at most kMaxHeight.
+  */
+  static size_t ValidateHeight(size_t height);
+
+  /*
+    Creates a tree whose nodes are kept in store, or in an InMemoryMerkleNodeStore if store is
+    nullptr. Nodes that are missing from the store have their default value, so a tree over an
+    empty store has only default_leaf leaves. n_threads is the maximal number of threads used by
+    UpdateLeaves().
+  */
+  explicit SparseMerkleTree(
+      size_t height, const PrimeFieldElement& default_leaf = PrimeFieldElement::Zero(),
+      size_t n_threads = GetNumHardwareThreads(),
+      std::unique_ptr<MerkleNodeStore> store = nullptr);
+
+  size_t Height() const { return height_; }
+
+  PrimeFieldElement GetRoot() const { return GetNode(1); }
+
+  PrimeFieldElement GetLeaf(uint64_t leaf_index) const;
+
+  PrimeFieldElement GetNode(uint64_t node_index) const;
+
+  /*
+    Returns the root of an empty subtree whose root is at the given level.
+  */
+  const PrimeFieldElement& GetDefaultNode(size_t level) const;
+
+  /*
+    Returns the number of nodes that are stored explicitly (i.e., differ from the default node of
+    their level).
+  */
+  size_t NumStoredNodes() const { return store_->NumStoredNodes(); }
+
+  /*
+    Sets the values of the given leaves and recomputes their ancestors. If a leaf appears more than
+    once, the last update wins.
+
+    Every ancestor of an updated leaf is hashed exactly once (shared ancestors are deduplicated),
+    and the hashes of each level are computed in parallel using PedersenHashBatch(). Thus, the cost
+    is about height * (number of updated leaves) hashes in the worst case, and less when the leaves
+    are close to each other.
+    All the modified nodes are passed to the store in a single MerkleNodeStore::Write() call.
+  */
+  void UpdateLeaves(gsl::span<const LeafUpdate> updates);
+
+ private:
+  /*
+    Returns the level of node_index, asserting that it is a valid node index.
+  */
+  size_t NodeLevel(uint64_t node_index) const;
+
+  /*
+    Appends to writes the writes that set the given nodes of the given level to values.
+  */
+  void AddNodeWrites(
+      size_t level, gsl::span<const uint64_t> node_indices,
+      gsl::span<const PrimeFieldElement> values,
+      std::vector<MerkleNodeStore::NodeWrite>* writes) const;
+
+  const size_t height_;
+  const size_t n_threads_;
+  const std::vector<PrimeFieldElement> default_nodes_;
+  std::unique_ptr<MerkleNodeStore> store_;
+};
+
+}  // namespace starkware
+
+#endif  // STARKWARE_MERKLE_SPARSE_MERKLE_TREE_H_
@@ -0,0 +1,129 @@
+#include "starkware/merkle/sparse_merkle_tree.h"
+
+#include <utility>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "starkware/crypto/pedersen_hash.h"
+#include "starkware/utils/math.h"
+#include "starkware/utils/prng.h"
+#include "starkware/utils/test_utils.h"
+
+namespace starkware {
+namespace {
+
+using testing::HasSubstr;
+using LeafUpdate = SparseMerkleTree::LeafUpdate;
+
+/*
+  Computes the root of a Merkle tree from all of its leaves.
+*/
+PrimeFieldElement NaiveRoot(std::vector<PrimeFieldElement> layer) {
+  while (layer.size() > 1) {
+    std::vector<PrimeFieldElement> next_layer;
+    for (size_t i = 0; i < layer.size(); i += 2) {
+      next_layer.push_back(PedersenHash(layer[i], layer[i + 1]));
+    }
+    layer = std::move(next_layer);
+  }
+  return layer[0];
+}
+
+TEST(SparseMerkleTree, DefaultNodes) {
+  const auto default_leaf = PrimeFieldElement::FromUint(7);
+  const SparseMerkleTree tree(3, default_leaf);
+  const auto level1 = PedersenHash(default_leaf, default_leaf);
+  const auto level2 = PedersenHash(level1, level1);
+  EXPECT_EQ(tree.GetDefaultNode(0), default_leaf);
+  EXPECT_EQ(tree.GetDefaultNode(1), level1);
+  EXPECT_EQ(tree.GetDefaultNode(2), level2);
+  EXPECT_EQ(tree.GetRoot(), PedersenHash(level2, level2));
+  EXPECT_EQ(tree.GetRoot(), ComputeDefaultNodes(3, default_leaf)[3]);
+  EXPECT_EQ(tree.NumStoredNodes(), 0U);
+}
+
+TEST(SparseMerkleTree, CompareToNaive) {
+  Prng prng;
+  const size_t height = 4;
+  SparseMerkleTree tree(height, PrimeFieldElement::Zero(), 3);
+  std::vector<PrimeFieldElement> leaves(Pow2(height), PrimeFieldElement::Zero());
+
+  for (size_t batch = 0; batch < 5; ++batch) {
+    std::vector<LeafUpdate> updates;
+    for (size_t i = 0; i < 6; ++i) {
+      const uint64_t leaf_index = prng.RandomUint64(0, leaves.size() - 1);
+      const auto value = PrimeFieldElement::RandomElement(&prng);
+      updates.emplace_back(leaf_index, value);
+      leaves[leaf_index] = value;
+    }
+    tree.UpdateLeaves(updates);
+
+    EXPECT_EQ(tree.GetRoot(), NaiveRoot(leaves));
+    for (size_t i = 0; i < leaves.size(); ++i) {
+      EXPECT_EQ(tree.GetLeaf(i), leaves[i]);
+    }
+  }
+}
+
+TEST(SparseMerkleTree, LastUpdateWins) {
+  const auto one = PrimeFieldElement::One();
+  const auto two = PrimeFieldElement::FromUint(2);
+  SparseMerkleTree tree(2);
+  const std::vector<LeafUpdate> updates = {{1, one}, {3, two}, {1, two}, {3, one}};
+  tree.UpdateLeaves(updates);
+  EXPECT_EQ(tree.GetLeaf(1), two);
+  EXPECT_EQ(tree.GetLeaf(3), one);
+  EXPECT_EQ(
+      tree.GetRoot(), NaiveRoot({PrimeFieldElement::Zero(), two, PrimeFieldElement::Zero(), one}));
+}
+
+TEST(SparseMerkleTree, ResetToDefaultReleasesNodes) {
+  Prng prng;
+  SparseMerkleTree tree(31);
+  const PrimeFieldElement empty_root = tree.GetRoot();
+  const std::vector<LeafUpdate> updates = {
+      {0, PrimeFieldElement::RandomElement(&prng)},
+      {Pow2(31) - 1, PrimeFieldElement::RandomElement(&prng)}};
+  tree.UpdateLeaves(updates);
+  EXPECT_NE(tree.GetRoot(), empty_root);
+  // Two paths of 32 nodes each, which share only the root.
+  EXPECT_EQ(tree.NumStoredNodes(), 63U);
+
+  const std::vector<LeafUpdate> reset = {
+      {0, PrimeFieldElement::Zero()}, {Pow2(31) - 1, PrimeFieldElement::Zero()}};
+  tree.UpdateLeaves(reset);
+  EXPECT_EQ(tree.GetRoot(), empty_root);
+  EXPECT_EQ(tree.NumStoredNodes(), 0U);
+}
+
+TEST(SparseMerkleTree, BatchEqualsSequential) {
+  Prng prng;
+  SparseMerkleTree batch_tree(31, PrimeFieldElement::Zero(), 4);
+  SparseMerkleTree sequential_tree(31, PrimeFieldElement::Zero(), 1);
+  std::vector<LeafUpdate> updates;
+  for (size_t i = 0; i < 40; ++i) {
+    updates.emplace_back(
+        prng.RandomUint64(0, Pow2(31) - 1), PrimeFieldElement::RandomElement(&prng));
+  }
+  batch_tree.UpdateLeaves(updates);
+  for (const auto& update : updates) {
+    sequential_tree.UpdateLeaves(gsl::make_span(&update, 1));
+  }
+  EXPECT_EQ(batch_tree.GetRoot(), sequential_tree.GetRoot());
+  EXPECT_EQ(batch_tree.NumStoredNodes(), sequential_tree.NumStoredNodes());
+}
+
+TEST(SparseMerkleTree, InvalidIndices) {
+  SparseMerkleTree tree(3);
+  const std::vector<LeafUpdate> updates = {{8, PrimeFieldElement::One()}};
+  EXPECT_ASSERT(tree.UpdateLeaves(updates), HasSubstr("out of range"));
+  EXPECT_ASSERT(tree.GetLeaf(8), HasSubstr("out of range"));
+  EXPECT_ASSERT(tree.GetNode(16), HasSubstr("out of range"));
+  EXPECT_ASSERT(tree.GetNode(0), HasSubstr("not a valid node index"));
+  EXPECT_ASSERT(SparseMerkleTree(63), HasSubstr("too big"));
+}
+
+}  // namespace
+}  // namespace starkware
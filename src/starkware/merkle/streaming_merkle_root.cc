@@ -0,0 +1,166 @@
+#include "starkware/merkle/streaming_merkle_root.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+
+#include "starkware/crypto/pedersen_hash.h"
+#include "starkware/merkle/sparse_merkle_tree.h"
+#include "starkware/utils/error_handling.h"
+#include "starkware/utils/math.h"
+
+namespace starkware {
+
+namespace {
+
+using ValueType = PrimeFieldElement::ValueType;
+
+}  // namespace
+
+StreamingMerkleRootBuilder::StreamingMerkleRootBuilder(
+    size_t height, const PrimeFieldElement& default_leaf, size_t n_threads)
+    : height_(SparseMerkleTree::ValidateHeight(height)),
+      n_threads_(n_threads),
+      default_nodes_(ComputeDefaultNodes(height, default_leaf)),
+      frontier_(height + 1) {}
+
+void StreamingMerkleRootBuilder::AddLeaves(gsl::span<const PrimeFieldElement> leaves) {
+  ASSERT(!finalized_, "Cannot add leaves after Finalize().");
+  ASSERT(leaves.size() <= Pow2(height_) - n_leaves_, "Too many leaves.");
+
+  // Split large inputs, so that the buffers are bounded by kChunkSize.
+  for (size_t chunk_start = 0; chunk_start < leaves.size(); chunk_start += kChunkSize) {
+    const auto chunk =
+        leaves.subspan(chunk_start, std::min(kChunkSize, leaves.size() - chunk_start));
+    n_leaves_ += chunk.size();
+
+    level_nodes_.clear();
+    if (frontier_[0].has_value()) {
+      level_nodes_.push_back(*frontier_[0]);
+      frontier_[0].reset();
+    }
+    level_nodes_.insert(level_nodes_.end(), chunk.begin(), chunk.end());
+
+    for (size_t level = 0; level < height_ && !level_nodes_.empty(); ++level) {
+      // A left child without its sibling waits in the frontier.
+      if (level_nodes_.size() % 2 == 1) {
+        frontier_[level] = level_nodes_.back();
+        level_nodes_.pop_back();
+      }
+
+      // The pending node of the next level precedes the parents of the nodes of this level.
+      next_level_nodes_.clear();
+      if (frontier_[level + 1].has_value()) {
+        next_level_nodes_.push_back(*frontier_[level + 1]);
+        frontier_[level + 1].reset();
+      }
+      const size_t offset = next_level_nodes_.size();
+      const size_t n_parents = level_nodes_.size() / 2;
+      next_level_nodes_.resize(offset + n_parents, PrimeFieldElement::Zero());
+
+      const auto parents = gsl::make_span(next_level_nodes_).subspan(offset);
+      const auto& children = level_nodes_;
+      ParallelFor(
+          n_parents, n_threads_,
+          [&children, &parents](size_t begin, size_t end) {
+            std::vector<PrimeFieldElement> left_children;
+            std::vector<PrimeFieldElement> right_children;
+            left_children.reserve(end - begin);
+            right_children.reserve(end - begin);
+            for (size_t i = begin; i < end; ++i) {
+              left_children.push_back(children[2 * i]);
+              right_children.push_back(children[2 * i + 1]);
+            }
+            PedersenHashBatch(left_children, right_children, parents.subspan(begin, end - begin));
+          },
+          SparseMerkleTree::kMinHashesPerThread);
+      std::swap(level_nodes_, next_level_nodes_);
+    }
+
+    // All the leaves were added, and level_nodes_ holds the root.
+    if (!level_nodes_.empty()) {
+      frontier_[height_] = level_nodes_[0];
+    }
+  }
+}
+
+void StreamingMerkleRootBuilder::AddLeavesFromBytes(gsl::span<const gsl::byte> data) {
+  ASSERT(data.size() % kLeafSize == 0, "Data size is not a multiple of the leaf size.");
+  std::vector<PrimeFieldElement> leaves;
+  leaves.reserve(std::min(kChunkSize, data.size() / kLeafSize));
+  for (size_t chunk_start = 0; chunk_start < data.size(); chunk_start += kChunkSize * kLeafSize) {
+    const size_t chunk_end = std::min(data.size(), chunk_start + kChunkSize * kLeafSize);
+    leaves.clear();
+    for (size_t offset = chunk_start; offset < chunk_end; offset += kLeafSize) {
+      const ValueType value = ValueType::FromLittleEndian(data.subspan(offset, kLeafSize));
+      ASSERT(value < PrimeFieldElement::kModulus, "Leaf is not a field element.");
+      leaves.push_back(PrimeFieldElement::FromBigInt(value));
+    }
+    AddLeaves(leaves);
+  }
+}
+
+void StreamingMerkleRootBuilder::AddLeavesFromStream(std::istream* stream) {
+  std::vector<gsl::byte> buffer(kChunkSize * kLeafSize);
+  while (*stream) {
+    stream->read(reinterpret_cast<char*>(buffer.data()), buffer.size());
+    const auto n_read = static_cast<size_t>(stream->gcount());
+    ASSERT(n_read % kLeafSize == 0, "Stream ended in the middle of a leaf.");
+    AddLeavesFromBytes(gsl::make_span(buffer).first(n_read));
+  }
+  ASSERT(!stream->bad(), "Failed to read from stream.");
+}
+
+void StreamingMerkleRootBuilder::AddLeavesFromFile(const std::string& path) {
+  const int fd = open(path.c_str(), O_RDONLY);
+  ASSERT(fd >= 0, "open failed for " + path + ": " + strerror(errno));
+  struct stat file_stat {};
+  const bool stat_ok = fstat(fd, &file_stat) == 0;
+  const auto file_size = static_cast<size_t>(file_stat.st_size);
+  // The mapping remains valid after the file is closed. An empty file cannot be mapped.
+  void* data = stat_ok && file_size > 0
+                   ? mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0)
+                   : nullptr;
+  const int error = errno;
+  close(fd);
+  ASSERT(stat_ok, "fstat failed for " + path + ": " + strerror(error));
+  if (file_size == 0) {
+    return;
+  }
+  ASSERT(data != MAP_FAILED, "mmap failed for " + path + ": " + strerror(error));
+  // The file is read once, from start to end, so its pages may be dropped after they are read.
+  madvise(data, file_size, MADV_SEQUENTIAL);
+  try {
+    AddLeavesFromBytes(gsl::make_span(static_cast<const gsl::byte*>(data), file_size));
+  } catch (...) {
+    munmap(data, file_size);
+    throw;
+  }
+  munmap(data, file_size);
+}
+
+PrimeFieldElement StreamingMerkleRootBuilder::Finalize() {
+  ASSERT(!finalized_, "Finalize() was already called.");
+  finalized_ = true;
+  if (frontier_[height_].has_value()) {
+    return *frontier_[height_];
+  }
+
+  // Complete the rightmost path, where all the nodes to the right of the added leaves are default
+  // nodes. node is the root of the subtree of the current level that contains the last leaf.
+  std::optional<PrimeFieldElement> node;
+  for (size_t level = 0; level < height_; ++level) {
+    if (frontier_[level].has_value()) {
+      node = PedersenHash(*frontier_[level], node.has_value() ? *node : default_nodes_[level]);
+    } else if (node.has_value()) {
+      node = PedersenHash(*node, default_nodes_[level]);
+    }
+  }
+  return node.has_value() ? *node : default_nodes_[height_];
+}
+
+}  // namespace starkware
@@ -0,0 +1,101 @@
+#ifndef STARKWARE_MERKLE_STREAMING_MERKLE_ROOT_H_
+#define STARKWARE_MERKLE_STREAMING_MERKLE_ROOT_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "third_party/gsl/gsl-lite.hpp"
+
+#include "starkware/algebra/prime_field_element.h"
+#include "starkware/utils/parallel.h"
+
+namespace starkware {
+
+/*
+  Computes the root of a Merkle tree (see SparseMerkleTree) from a stream of its leaves, in order,
+  without keeping the tree in memory.
+
+  Only a frontier of at most one pending node per level is kept between calls, so the memory in use
+  is O(height) plus the buffers of a single chunk of leaves, regardless of the number of leaves.
+  The leaves of a chunk are hashed level by level, each level with PedersenHashBatch().
+
+  Usage:
+    StreamingMerkleRootBuilder builder(31);
+    builder.AddLeaves(first_chunk);
+    builder.AddLeaves(second_chunk);
+    PrimeFieldElement root = builder.Finalize();
+*/
+class StreamingMerkleRootBuilder {
+ public:
+  /*
+    The number of leaves that are decoded and hashed together by AddLeavesFromBytes().
+  */
+  static constexpr size_t kChunkSize = 4096;
+
+  /*
+    The size of a serialized leaf: 32-byte little-endian, as in Serialize() of ffi/utils.h.
+  */
+  static constexpr size_t kLeafSize = 32;
+
+  /*
+    Creates a builder of a tree with 2^height leaves. Leaves that are not added before Finalize()
+    is called are default_leaf. n_threads is the maximal number of threads used for hashing.
+  */
+  explicit StreamingMerkleRootBuilder(
+      size_t height, const PrimeFieldElement& default_leaf = PrimeFieldElement::Zero(),
+      size_t n_threads = GetNumHardwareThreads());
+
+  /*
+    Appends leaves to the tree.
+  */
+  void AddLeaves(gsl::span<const PrimeFieldElement> leaves);
+
+  /*
+    Appends the leaves serialized in data, whose size must be a multiple of kLeafSize.
+  */
+  void AddLeavesFromBytes(gsl::span<const gsl::byte> data);
+
+  /*
+    Appends all the leaves that can be read from stream (until its end).
+  */
+  void AddLeavesFromStream(std::istream* stream);
+
+  /*
+    Appends all the serialized leaves in the file at path. The file is memory-mapped and read
+    sequentially, so it may be much larger than the available memory.
+  */
+  void AddLeavesFromFile(const std::string& path);
+
+  uint64_t NumLeaves() const { return n_leaves_; }
+
+  /*
+    Returns the root of the tree, where the leaves that were not added are default_leaf. No leaf may
+    be added afterwards.
+  */
+  PrimeFieldElement Finalize();
+
+ private:
+  const size_t height_;
+  const size_t n_threads_;
+  const std::vector<PrimeFieldElement> default_nodes_;
+  uint64_t n_leaves_ = 0;
+  bool finalized_ = false;
+
+  /*
+    frontier_[level] is the last node of the given level if it is a left child (so its parent is not
+    known yet). frontier_[height_] is the root once all the leaves were added.
+  */
+  std::vector<std::optional<PrimeFieldElement>> frontier_;
+
+  // Buffers for the nodes of the current and next level, reused between calls.
+  std::vector<PrimeFieldElement> level_nodes_;
+  std::vector<PrimeFieldElement> next_level_nodes_;
+};
+
+}  // namespace starkware
+
+#endif  // STARKWARE_MERKLE_STREAMING_MERKLE_ROOT_H_
@@ -0,0 +1,136 @@
+#include "starkware/merkle/streaming_merkle_root.h"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "starkware/merkle/sparse_merkle_tree.h"
+#include "starkware/utils/math.h"
+#include "starkware/utils/prng.h"
+#include "starkware/utils/test_utils.h"
+
+namespace starkware {
+namespace {
+
+using testing::HasSubstr;
+using LeafUpdate = SparseMerkleTree::LeafUpdate;
+using ValueType = PrimeFieldElement::ValueType;
+
+std::vector<PrimeFieldElement> RandomLeaves(size_t n_leaves, Prng* prng) {
+  std::vector<PrimeFieldElement> leaves;
+  leaves.reserve(n_leaves);
+  for (size_t i = 0; i < n_leaves; ++i) {
+    leaves.push_back(PrimeFieldElement::RandomElement(prng));
+  }
+  return leaves;
+}
+
+PrimeFieldElement ExpectedRoot(
+    size_t height, const std::vector<PrimeFieldElement>& leaves,
+    const PrimeFieldElement& default_leaf) {
+  SparseMerkleTree tree(height, default_leaf);
+  std::vector<LeafUpdate> updates;
+  for (size_t i = 0; i < leaves.size(); ++i) {
+    updates.emplace_back(i, leaves[i]);
+  }
+  tree.UpdateLeaves(updates);
+  return tree.GetRoot();
+}
+
+/*
+  Serializes the leaves as 32-byte little-endian values.
+*/
+std::string SerializeLeaves(const std::vector<PrimeFieldElement>& leaves) {
+  std::string data;
+  for (const auto& leaf : leaves) {
+    const ValueType value = leaf.ToStandardForm();
+    for (size_t i = 0; i < ValueType::LimbCount(); ++i) {
+      for (size_t j = 0; j < sizeof(uint64_t); ++j) {
+        data.push_back(static_cast<char>((value[i] >> (8 * j)) & 0xff));
+      }
+    }
+  }
+  return data;
+}
+
+TEST(StreamingMerkleRoot, CompareToTree) {
+  Prng prng;
+  const size_t height = 5;
+  const auto default_leaf = PrimeFieldElement::RandomElement(&prng);
+  for (const size_t n_leaves : {0, 1, 2, 3, 7, 16, 21, 31, 32}) {
+    const std::vector<PrimeFieldElement> leaves = RandomLeaves(n_leaves, &prng);
+
+    // Add the leaves in chunks of random sizes.
+    StreamingMerkleRootBuilder builder(height, default_leaf, 2);
+    for (size_t start = 0; start < n_leaves;) {
+      const size_t size = prng.RandomUint64(1, n_leaves - start);
+      builder.AddLeaves(gsl::make_span(leaves).subspan(start, size));
+      start += size;
+    }
+    EXPECT_EQ(builder.NumLeaves(), n_leaves);
+    EXPECT_EQ(builder.Finalize(), ExpectedRoot(height, leaves, default_leaf))
+        << "n_leaves = " << n_leaves;
+  }
+}
+
+TEST(StreamingMerkleRoot, ZeroHeight) {
+  Prng prng;
+  const auto leaf = PrimeFieldElement::RandomElement(&prng);
+  StreamingMerkleRootBuilder builder(0);
+  builder.AddLeaves(std::vector<PrimeFieldElement>{leaf});
+  EXPECT_EQ(builder.Finalize(), leaf);
+  EXPECT_EQ(StreamingMerkleRootBuilder(0, leaf).Finalize(), leaf);
+}
+
+TEST(StreamingMerkleRoot, FromStream) {
+  Prng prng;
+  const size_t height = 4;
+  const std::vector<PrimeFieldElement> leaves = RandomLeaves(11, &prng);
+  std::istringstream stream(SerializeLeaves(leaves));
+  StreamingMerkleRootBuilder builder(height);
+  builder.AddLeavesFromStream(&stream);
+  EXPECT_EQ(builder.NumLeaves(), leaves.size());
+  EXPECT_EQ(builder.Finalize(), ExpectedRoot(height, leaves, PrimeFieldElement::Zero()));
+}
+
+TEST(StreamingMerkleRoot, FromFileWithMoreThanOneChunk) {
+  Prng prng;
+  const size_t height = 13;
+  const std::vector<PrimeFieldElement> leaves =
+      RandomLeaves(StreamingMerkleRootBuilder::kChunkSize + 5, &prng);
+  const std::string path =
+      ::testing::TempDir() + "streaming_merkle_root_" + std::to_string(prng.RandomUint64());
+  std::ofstream(path, std::ios::binary) << SerializeLeaves(leaves);
+
+  StreamingMerkleRootBuilder builder(height);
+  builder.AddLeavesFromFile(path);
+  std::remove(path.c_str());
+  EXPECT_EQ(builder.NumLeaves(), leaves.size());
+  EXPECT_EQ(builder.Finalize(), ExpectedRoot(height, leaves, PrimeFieldElement::Zero()));
+}
+
+TEST(StreamingMerkleRoot, InvalidInput) {
+  Prng prng;
+  StreamingMerkleRootBuilder builder(2);
+  builder.AddLeaves(RandomLeaves(3, &prng));
+  EXPECT_ASSERT(builder.AddLeaves(RandomLeaves(2, &prng)), HasSubstr("Too many leaves"));
+
+  std::istringstream partial_leaf(std::string(40, '\0'));
+  EXPECT_ASSERT(builder.AddLeavesFromStream(&partial_leaf), HasSubstr("middle of a leaf"));
+
+  const std::vector<gsl::byte> not_a_field_element(32, gsl::byte{0xff});
+  EXPECT_ASSERT(
+      builder.AddLeavesFromBytes(not_a_field_element), HasSubstr("not a field element"));
+
+  builder.Finalize();
+  EXPECT_ASSERT(builder.AddLeaves(RandomLeaves(1, &prng)), HasSubstr("after Finalize"));
+  EXPECT_ASSERT(builder.Finalize(), HasSubstr("already called"));
+}
+
+}  // namespace
+}  // namespace starkware
@@ -0,0 +1,148 @@
+#ifndef STARKWARE_UTILS_CONCURRENT_LRU_CACHE_H_
+#define STARKWARE_UTILS_CONCURRENT_LRU_CACHE_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "starkware/utils/error_handling.h"
+
+namespace starkware {
+
+/*
+  A bounded key-value cache that may be used from multiple threads, optimized for workloads that
+  are dominated by lookups of a relatively small set of hot keys.
+
+  The cache is split into shards by the hash of the key. A lookup takes only a shared lock of its
+  shard, so lookups never wait for each other, and marks the entry as recently used with a relaxed
+  atomic store. Only insertions take the shard exclusively.
+
+  Eviction uses the CLOCK approximation of LRU: when a full shard needs room, a hand sweeps over its
+  entries, clearing the "recently used" mark of every entry it passes, and evicts the first entry
+  that was not used since the previous sweep. This keeps lookups free of any list manipulation.
+*/
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class ConcurrentLruCache {
+ public:
+  static constexpr size_t kDefaultNumShards = 16;
+
+  /*
+    Creates a cache of about capacity entries (rounded up to a multiple of the number of shards).
+  */
+  explicit ConcurrentLruCache(size_t capacity, size_t n_shards = kDefaultNumShards) {
+    ASSERT(capacity > 0, "Cache capacity must be positive.");
+    n_shards = std::max<size_t>(std::min(n_shards, capacity), 1);
+    const size_t shard_capacity = (capacity + n_shards - 1) / n_shards;
+    shards_.reserve(n_shards);
+    for (size_t i = 0; i < n_shards; ++i) {
+      shards_.push_back(std::make_unique<Shard>(shard_capacity));
+    }
+  }
+
+  /*
+    Returns the value of key, or std::nullopt if it is not in the cache.
+  */
+  std::optional<Value> Get(const Key& key) const {
+    const Shard& shard = GetShard(key);
+    {
+      std::shared_lock<std::shared_mutex> lock(shard.mutex);
+      const auto it = shard.index.find(key);
+      if (it != shard.index.end()) {
+        shard.recently_used[it->second].store(true, std::memory_order_relaxed);
+        hits_.fetch_add(1, std::memory_order_relaxed);
+        return shard.entries[it->second]->second;
+      }
+    }
+    misses_.fetch_add(1, std::memory_order_relaxed);
+    return std::nullopt;
+  }
+
+  /*
+    Sets the value of key, evicting an entry that was not used recently if needed.
+  */
+  void Insert(const Key& key, const Value& value) {
+    Shard& shard = GetShard(key);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    const auto it = shard.index.find(key);
+    if (it != shard.index.end()) {
+      shard.entries[it->second]->second = value;
+      return;
+    }
+
+    const size_t shard_capacity = shard.recently_used.size();
+    size_t slot = shard.entries.size();
+    if (slot < shard_capacity) {
+      shard.entries.emplace_back();
+    } else {
+      while (shard.recently_used[shard.hand].exchange(false, std::memory_order_relaxed)) {
+        shard.hand = (shard.hand + 1) % shard_capacity;
+      }
+      slot = shard.hand;
+      shard.hand = (shard.hand + 1) % shard_capacity;
+      shard.index.erase(shard.entries[slot]->first);
+    }
+    shard.entries[slot].emplace(key, value);
+    shard.index.emplace(key, slot);
+  }
+
+  /*
+    Returns the number of entries in the cache.
+  */
+  size_t Size() const {
+    size_t size = 0;
+    for (const auto& shard : shards_) {
+      std::shared_lock<std::shared_mutex> lock(shard->mutex);
+      size += shard->index.size();
+    }
+    return size;
+  }
+
+  /*
+    Returns the number of calls to Get() that found, or did not find, their key.
+  */
+  uint64_t Hits() const { return hits_.load(std::memory_order_relaxed); }
+  uint64_t Misses() const { return misses_.load(std::memory_order_relaxed); }
+
+  /*
+    Returns the fraction of the calls to Get() that found their key, or 0 if there were none.
+  */
+  double HitRatio() const {
+    const uint64_t hits = Hits();
+    const uint64_t lookups = hits + Misses();
+    return lookups == 0 ? 0 : static_cast<double>(hits) / static_cast<double>(lookups);
+  }
+
+ private:
+  struct Shard {
+    explicit Shard(size_t capacity) : recently_used(capacity) { entries.reserve(capacity); }
+
+    mutable std::shared_mutex mutex;
+    // Maps a key to its slot in entries.
+    std::unordered_map<Key, size_t, Hash> index;
+    std::vector<std::optional<std::pair<Key, Value>>> entries;
+    // recently_used[i] is set when entries[i] is found by Get(). Its size is the shard capacity.
+    mutable std::vector<std::atomic<bool>> recently_used;
+    // The position of the CLOCK hand.
+    size_t hand = 0;
+  };
+
+  const Shard& GetShard(const Key& key) const { return *shards_[Hash()(key) % shards_.size()]; }
+  Shard& GetShard(const Key& key) { return *shards_[Hash()(key) % shards_.size()]; }
+
+  std::vector<std::unique_ptr<Shard>> shards_;
+  mutable std::atomic<uint64_t> hits_{0};
+  mutable std::atomic<uint64_t> misses_{0};
+};
+
+}  // namespace starkware
+
+#endif  // STARKWARE_UTILS_CONCURRENT_LRU_CACHE_H_
@@ -0,0 +1,83 @@
+#include "starkware/utils/concurrent_lru_cache.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "starkware/utils/test_utils.h"
+
+namespace starkware {
+namespace {
+
+using testing::HasSubstr;
+
+TEST(ConcurrentLruCache, GetAndInsert) {
+  ConcurrentLruCache<int, std::string> cache(10);
+  EXPECT_EQ(cache.HitRatio(), 0);
+  EXPECT_EQ(cache.Get(1), std::nullopt);
+  cache.Insert(1, "one");
+  cache.Insert(2, "two");
+  EXPECT_EQ(cache.Get(1), "one");
+  EXPECT_EQ(cache.Get(2), "two");
+  cache.Insert(1, "uno");
+  EXPECT_EQ(cache.Get(1), "uno");
+  EXPECT_EQ(cache.Size(), 2U);
+  EXPECT_EQ(cache.Hits(), 3U);
+  EXPECT_EQ(cache.Misses(), 1U);
+  EXPECT_EQ(cache.HitRatio(), 0.75);
+  EXPECT_ASSERT((ConcurrentLruCache<int, int>(0)), HasSubstr("positive"));
+}
+
+TEST(ConcurrentLruCache, EvictsEntriesThatWereNotUsed) {
+  ConcurrentLruCache<int, int> cache(4, 1);
+  for (int i = 0; i < 4; ++i) {
+    cache.Insert(i, i);
+  }
+  // Use all the entries but 2, which is then the one to be evicted.
+  for (int i : {0, 1, 3}) {
+    EXPECT_EQ(cache.Get(i), i);
+  }
+  cache.Insert(4, 4);
+  EXPECT_EQ(cache.Size(), 4U);
+  EXPECT_EQ(cache.Get(2), std::nullopt);
+  for (int i : {0, 1, 3, 4}) {
+    EXPECT_EQ(cache.Get(i), i);
+  }
+}
+
+TEST(ConcurrentLruCache, SizeIsBounded) {
+  ConcurrentLruCache<int, int> cache(64, 4);
+  for (int i = 0; i < 1000; ++i) {
+    cache.Insert(i, i);
+  }
+  EXPECT_EQ(cache.Size(), 64U);
+}
+
+TEST(ConcurrentLruCache, ConcurrentAccess) {
+  ConcurrentLruCache<int, int> cache(32);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&cache, t]() {
+      for (int i = 0; i < 2000; ++i) {
+        const int key = (i * 7 + t) % 50;
+        const auto value = cache.Get(key);
+        if (value.has_value()) {
+          ASSERT_EQ(*value, key * 2);
+        } else {
+          cache.Insert(key, key * 2);
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(cache.Hits() + cache.Misses(), 8000U);
+  EXPECT_LE(cache.Size(), 32U);
+}
+
+}  // namespace
+}  // namespace starkware
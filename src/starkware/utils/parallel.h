@@ -0,0 +1,70 @@
+#ifndef STARKWARE_UTILS_PARALLEL_H_
+#define STARKWARE_UTILS_PARALLEL_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace starkware {
+
+using std::size_t;
+
+/*
+  Returns the number of threads that can run concurrently on this machine (at least 1).
+*/
+inline size_t GetNumHardwareThreads() {
+  return std::max<size_t>(std::thread::hardware_concurrency(), 1);
+}
+
+/*
+  Splits the range [0, n_items) into at most n_threads contiguous chunks of at least
+  min_items_per_thread items each, and calls func(begin, end) for every chunk, each on its own
+  thread. The calling thread processes the first chunk. Returns only after all the chunks were
+  processed.
+  If func throws, the first exception (in chunk order) is rethrown in the calling thread.
+*/
+template <typename Func>
+void ParallelFor(
+    size_t n_items, size_t n_threads, const Func& func, size_t min_items_per_thread = 1) {
+  const size_t max_chunks =
+      std::max<size_t>(n_items / std::max<size_t>(min_items_per_thread, 1), 1);
+  const size_t n_chunks = std::min(std::max<size_t>(n_threads, 1), max_chunks);
+  if (n_chunks == 1) {
+    func(size_t{0}, n_items);
+    return;
+  }
+
+  const size_t chunk_size = (n_items + n_chunks - 1) / n_chunks;
+  std::vector<std::exception_ptr> exceptions(n_chunks);
+  auto run_chunk = [&](size_t chunk) {
+    const size_t begin = std::min(chunk * chunk_size, n_items);
+    const size_t end = std::min(begin + chunk_size, n_items);
+    try {
+      func(begin, end);
+    } catch (...) {
+      exceptions[chunk] = std::current_exception();
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(n_chunks - 1);
+  for (size_t chunk = 1; chunk < n_chunks; ++chunk) {
+    threads.emplace_back(run_chunk, chunk);
+  }
+  run_chunk(0);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (const auto& exception : exceptions) {
+    if (exception) {
+      std::rethrow_exception(exception);
+    }
+  }
+}
+
+}  // namespace starkware
+
+#endif  // STARKWARE_UTILS_PARALLEL_H_
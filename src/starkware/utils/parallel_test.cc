@@ -0,0 +1,48 @@
+#include "starkware/utils/parallel.h"
+
+#include <atomic>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "starkware/utils/error_handling.h"
+#include "starkware/utils/test_utils.h"
+
+namespace starkware {
+namespace {
+
+using testing::HasSubstr;
+
+TEST(ParallelFor, CoversRangeExactlyOnce) {
+  for (size_t n_threads : {1, 2, 3, 8}) {
+    for (size_t n_items : {0, 1, 5, 100, 1001}) {
+      std::vector<std::atomic<int>> counters(n_items);
+      ParallelFor(n_items, n_threads, [&counters](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+          counters[i]++;
+        }
+      });
+      for (const auto& counter : counters) {
+        EXPECT_EQ(counter, 1);
+      }
+    }
+  }
+}
+
+TEST(ParallelFor, MinItemsPerThread) {
+  std::atomic<int> n_calls{0};
+  ParallelFor(10, 8, [&n_calls](size_t /*begin*/, size_t /*end*/) { n_calls++; }, 5);
+  EXPECT_EQ(n_calls, 2);
+}
+
+TEST(ParallelFor, PropagatesException) {
+  EXPECT_ASSERT(
+      ParallelFor(
+          100, 4,
+          [](size_t begin, size_t /*end*/) { ASSERT(begin == 0, "Chunk failed."); }),
+      HasSubstr("Chunk failed."));
+}
+
+}  // namespace
+}  // namespace starkware
@@ -1,5 +1,5 @@
-#ifndef STARKWARE_CRYPTO_FFI_PORTABLE_ENDIAN_H_
-#define STARKWARE_CRYPTO_FFI_PORTABLE_ENDIAN_H_
+#ifndef STARKWARE_UTILS_PORTABLE_ENDIAN_H_
+#define STARKWARE_UTILS_PORTABLE_ENDIAN_H_
 
 #if (defined(_WIN16) || defined(_WIN32) || defined(_WIN64)) && !defined(__WINDOWS__)
 
@@ -109,4 +109,4 @@
 
 #endif
 
-#endif  // STARKWARE_CRYPTO_FFI_PORTABLE_ENDIAN_H_
\ No newline at end of file
+#endif  // STARKWARE_UTILS_PORTABLE_ENDIAN_H_
\ No newline at end of file